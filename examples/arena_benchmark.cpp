@@ -0,0 +1,160 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026 MH Lim
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// requires C++11
+
+// This program compares request-scoped allocations made from res_mgr::Arena with one calloc per object (DynamicMemory).
+// Every simulated request allocates a few hundred objects of 16 to 256 bytes and a growing std::vector, then releases them all.
+
+#include "res_mgr_arena.hpp"
+#include "res_mgr_resource.hpp"
+#include "benchmark.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+struct DynamicMemoryFunctor
+{
+	static void* allocate(size_t number_of_bytes) {
+		return calloc(number_of_bytes, sizeof(unsigned char));
+	}
+
+	void operator()(void* memory) {
+		free(memory);
+	}
+
+	bool operator()(void* memory_address, void* invalid_address) { return (memory_address != invalid_address); }
+};
+
+typedef res_mgr::Resource<void*, nullptr, DynamicMemoryFunctor> DynamicMemory;
+typedef std::vector<unsigned int, res_mgr::ArenaAllocator<unsigned int> > ArenaVector;
+
+static const size_t objects_per_request = 400U;
+static const size_t values_per_request = 1000U;
+
+// The same object sizes are used by both variants.
+static size_t get_object_size(size_t i)
+{
+	return 16U + ((i * 2654435761U) >> 7) % 241U;
+}
+
+// The object array is reused, so that only the allocations of the objects themselves are measured.
+static void handle_requests_with_calloc(size_t request_count, std::vector<DynamicMemory>& objects)
+{
+	for (size_t r = 0U; r < request_count; ++r) {
+		for (size_t i = 0U; i < objects_per_request; ++i) {
+			objects.push_back(DynamicMemory(DynamicMemoryFunctor::allocate(get_object_size(i))));
+			static_cast<unsigned char*>(objects.back().get())[0] = static_cast<unsigned char>(i);
+		}
+		std::vector<unsigned int> values;
+		for (size_t i = 0U; i < values_per_request; ++i)
+			values.push_back(static_cast<unsigned int>(i));
+		benchmark::do_not_optimize(values.back());
+		objects.clear();
+	}
+}
+
+// The memory of the arena is cleared like the memory returned by calloc.
+static void handle_requests_with_arena(size_t request_count, res_mgr::Arena& arena)
+{
+	for (size_t r = 0U; r < request_count; ++r) {
+		for (size_t i = 0U; i < objects_per_request; ++i) {
+			const size_t size = get_object_size(i);
+			unsigned char* object = static_cast<unsigned char*>(memset(arena.allocate(size), 0, size));
+			object[0] = static_cast<unsigned char>(i);
+			benchmark::do_not_optimize(object);
+		}
+		ArenaVector values((res_mgr::ArenaAllocator<unsigned int>(arena)));
+		for (size_t i = 0U; i < values_per_request; ++i)
+			values.push_back(static_cast<unsigned int>(i));
+		benchmark::do_not_optimize(values.back());
+		arena.reset();
+	}
+}
+
+static bool check_arena()
+{
+	res_mgr::Arena arena(256U);
+	for (size_t i = 0U; i < 100U; ++i) {
+		const size_t alignment = size_t(1U) << (i % 8U);
+		void* p = arena.allocate(get_object_size(i), alignment);
+		if (reinterpret_cast<size_t>(p) % alignment != 0U) {
+			printf("Error: an allocation of the arena is not aligned to %lu bytes\n", static_cast<unsigned long>(alignment));
+			return false;
+		}
+		memset(p, 0xFF, get_object_size(i));
+	}
+
+	const res_mgr::ArenaStats before = arena.get_stats();
+	arena.reset();
+	const res_mgr::ArenaStats after = arena.get_stats();
+	if (before.region_count < 2U || after.region_count != 1U || after.capacity != before.capacity || after.used != 0U) {
+		printf("Error: the arena was not reset to a single region of %lu bytes\n", static_cast<unsigned long>(before.capacity));
+		return false;
+	}
+
+	ArenaVector values((res_mgr::ArenaAllocator<unsigned int>(arena)));
+	for (unsigned int i = 0U; i < 10000U; ++i)
+		values.push_back(i);
+	for (unsigned int i = 0U; i < 10000U; ++i) {
+		if (values[i] != i) {
+			printf("Error: the std::vector allocated from the arena is corrupted\n");
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char *argv[])
+{
+	size_t request_count = 0U;
+	if (!benchmark::parse_count_argument(argc, argv, "requests", 10000U, request_count))
+		return 1;
+	const int repetitions = 5;
+	if (!check_arena())
+		return 1;
+
+	printf("Handling %lu requests of %lu objects and a std::vector of %lu values, best of %d runs\n", static_cast<unsigned long>(request_count),
+		static_cast<unsigned long>(objects_per_request), static_cast<unsigned long>(values_per_request), repetitions);
+
+	std::vector<DynamicMemory> objects;
+	objects.reserve(objects_per_request);
+	const double calloc_ns = benchmark::best_of(repetitions, [request_count, &objects]() {
+		handle_requests_with_calloc(request_count, objects);
+	});
+	benchmark::report("calloc per object (DynamicMemory)", calloc_ns, request_count);
+
+	// The arena starts small and grows to the size of a request after the first reset().
+	res_mgr::Arena arena(4096U);
+	const double arena_ns = benchmark::best_of(repetitions, [request_count, &arena]() {
+		handle_requests_with_arena(request_count, arena);
+	});
+	benchmark::report("arena with reset per request", arena_ns, request_count);
+
+	const res_mgr::ArenaStats stats = arena.get_stats();
+	printf("The arena has %lu region(s) of %lu bytes in total\n", static_cast<unsigned long>(stats.region_count), static_cast<unsigned long>(stats.capacity));
+	return 0;
+}
@@ -25,6 +25,7 @@ SOFTWARE.
 // requires C++11
 
 #include "res_mgr_atomic.hpp"
+#include "res_mgr_counter.hpp"
 #include <atomic>
 #include <assert.h>
 #include <stdio.h>
@@ -37,9 +38,11 @@ SOFTWARE.
 #include <unistd.h>
 #endif
 
-typedef std::atomic<unsigned int> atomic_uint_type;
-typedef std::atomic<int> atomic_int_type;
-typedef std::atomic<bool> atomic_bool;
+// Every member is on its own cache line, so the threads updating one member do not slow down the updates of the others.
+typedef res_mgr::PaddedAtomic<unsigned int> atomic_uint_type;
+typedef res_mgr::PaddedAtomic<int> atomic_int_type;
+typedef res_mgr::PaddedAtomic<bool> atomic_bool;
+typedef res_mgr::ShardedCounter<unsigned int> sharded_uint_type;
 
 struct thread_data_type {
 	atomic_int_type increasing_number;
@@ -51,6 +54,7 @@ struct thread_data_type {
 	atomic_uint_type uint3;
 	atomic_uint_type thread_count;
 	atomic_bool exit;
+	sharded_uint_type iteration_count;
 
 	thread_data_type() :
 		increasing_number(0),
@@ -61,7 +65,8 @@ struct thread_data_type {
 		uint2(0U),
 		uint3(0U),
 		thread_count(0U),
-		exit(false)
+		exit(false),
+		iteration_count(0U)
 	{
 	}
 };
@@ -77,7 +82,7 @@ void *thread_procedure(void *param)
 	const unsigned int thread_id = res_mgr::atomic_increment<unsigned int, atomic_uint_type>(&(data->thread_count));
 
 	for (;;) {
-		const bool exit = res_mgr::atomic_load<bool, atomic_bool>(&(data->exit));
+		const bool exit = res_mgr::atomic_load<bool, atomic_bool>(&(data->exit), res_mgr::memory_order_acquire);
 		if (!exit) {
 			const int increasing_number = res_mgr::atomic_increment<int, atomic_int_type>(&(data->increasing_number));
 			const int decreasing_number = res_mgr::atomic_decrement<int, atomic_int_type>(&(data->decreasing_number));
@@ -86,6 +91,7 @@ void *thread_procedure(void *param)
 			const unsigned int pattern1 = res_mgr::atomic_and<unsigned int, atomic_uint_type>(&(data->uint1), 0xFFU);
 			const unsigned int pattern2 = res_mgr::atomic_or<unsigned int, atomic_uint_type>(&(data->uint2), 0xFFFFU);
 			const unsigned int pattern3 = res_mgr::atomic_xor<unsigned int, atomic_uint_type>(&(data->uint3), 0xFFFFFFFFU);
+			res_mgr::atomic_increment<unsigned int, sharded_uint_type>(&(data->iteration_count));
 
 			printf("Thread %u: n1=%d, n2=%d, n3=%d, n4=%d, n5=%X, n6=%X, n7=%X\n", thread_id, increasing_number, decreasing_number,
 					increasing_number2, decreasing_number2, pattern1, pattern2, pattern3);
@@ -133,7 +139,7 @@ int main(void)
 	sleep(seconds);
 #endif
 
-	res_mgr::atomic_store(&(data.exit), true);
+	res_mgr::atomic_store(&(data.exit), true, res_mgr::memory_order_release);
 
 #if defined _WIN32 || defined _WIN64
 	WaitForMultipleObjects(MAX_THREAD_COUNT, threads, TRUE, INFINITE);
@@ -142,5 +148,17 @@ int main(void)
 		pthread_join(threads[i], NULL);
 #endif
 
+	const unsigned int iteration_count = res_mgr::atomic_load<unsigned int, sharded_uint_type>(&(data.iteration_count));
+	printf("Iterations: %u\n", iteration_count);
+	const int increasing_number = res_mgr::atomic_load<int, atomic_int_type>(&(data.increasing_number));
+	assert(static_cast<int>(iteration_count) == increasing_number);
+	(void) increasing_number;
+
+	// The worker threads have exited, so the counter can be reset.
+	res_mgr::atomic_store<unsigned int, sharded_uint_type>(&(data.iteration_count), 0U);
+	const unsigned int reset_count = res_mgr::atomic_load<unsigned int, sharded_uint_type>(&(data.iteration_count));
+	assert(reset_count == 0U);
+	(void) reset_count;
+
 	return 0;
 }
@@ -0,0 +1,246 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026 MH Lim
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// requires C++11
+
+#ifndef RESOURCE_MANAGER_BENCHMARK_HPP
+#define RESOURCE_MANAGER_BENCHMARK_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+// A minimal timing helper shared by the benchmark programs in this folder.
+namespace benchmark {
+
+typedef std::chrono::steady_clock clock_type;
+
+class Timer
+{
+public:
+	Timer() : m_start(clock_type::now())
+	{
+	}
+
+	void restart()
+	{
+		m_start = clock_type::now();
+	}
+
+	double elapsed_ns() const
+	{
+		return std::chrono::duration<double, std::nano>(clock_type::now() - m_start).count();
+	}
+
+private:
+	clock_type::time_point m_start;
+};
+
+// Prevents the compiler from optimizing away a value computed by the benchmarked code.
+template<typename T>
+inline void do_not_optimize(const T& value)
+{
+#if defined __GNUC__ || defined __clang__
+	asm volatile("" : : "g"(&value) : "memory");
+#else
+	static volatile const void* sink;
+	sink = &value;
+#endif
+}
+
+// Runs the function a number of times and returns the best (lowest) time in nanoseconds.
+template<class Function>
+inline double best_of(int repetitions, Function function)
+{
+	double best = 0.0;
+	for (int i = 0; i < repetitions; ++i) {
+		Timer timer;
+		function();
+		const double elapsed = timer.elapsed_ns();
+		if (i == 0 || elapsed < best)
+			best = elapsed;
+	}
+	return best;
+}
+
+inline void report(const char* name, double total_ns, size_t operations)
+{
+	const double ns_per_op = (operations > 0U) ? (total_ns / static_cast<double>(operations)) : 0.0;
+	const double ops_per_second = (total_ns > 0.0) ? (static_cast<double>(operations) * 1e9 / total_ns) : 0.0;
+	printf("%-48s %12.2f ns/op %16.0f ops/s\n", name, ns_per_op, ops_per_second);
+}
+
+// Parses a positive decimal number, returns false if the text is not one or does not fit in a size_t.
+inline bool parse_count(const char* text, size_t& count)
+{
+	if (text == NULL || *text < '0' || *text > '9')
+		return false;
+	char* end = NULL;
+	errno = 0;
+	const unsigned long long value = strtoull(text, &end, 10);
+	if (errno != 0 || *end != '\0' || value == 0U || value > SIZE_MAX)
+		return false;
+	count = static_cast<size_t>(value);
+	return true;
+}
+
+// Reads the count given as the only argument of a benchmark program, default_count is used if there is none.
+// Prints the usage and returns false if there are more arguments or the argument is not a positive number.
+inline bool parse_count_argument(int argc, char* argv[], const char* name, size_t default_count, size_t& count)
+{
+	count = default_count;
+	if (argc <= 1 || (argc == 2 && parse_count(argv[1], count)))
+		return true;
+	printf("Usage: %s [<%s>]\n", argv[0], name);
+	printf("  <%s>: a positive number, %lu by default\n", name, static_cast<unsigned long>(default_count));
+	return false;
+}
+
+// The distribution of the time per operation over the samples of a benchmark.
+struct Statistics
+{
+	size_t operations; // the number of operations per sample
+	int samples;
+	double min_ns;
+	double mean_ns;
+	double p50_ns;
+	double p90_ns;
+	double p99_ns;
+	double max_ns;
+
+	double ops_per_second() const
+	{
+		return (p50_ns > 0.0) ? (1e9 / p50_ns) : 0.0;
+	}
+};
+
+// Runs the function a number of times, each run performs the given number of operations.
+// The percentiles are those of the time per operation of the runs, not of single operations, which are too short to be timed.
+template<class Function>
+inline Statistics sample(int samples, size_t operations, Function function)
+{
+	std::vector<double> ns_per_op;
+	function(); // warm up
+	for (int i = 0; i < samples; ++i) {
+		Timer timer;
+		function();
+		ns_per_op.push_back(timer.elapsed_ns() / static_cast<double>((operations > 0U) ? operations : 1U));
+	}
+	std::sort(ns_per_op.begin(), ns_per_op.end());
+
+	Statistics statistics = { operations, samples, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+	if (ns_per_op.empty())
+		return statistics;
+	double sum = 0.0;
+	for (size_t i = 0U; i < ns_per_op.size(); ++i)
+		sum += ns_per_op[i];
+	const size_t last = ns_per_op.size() - 1U;
+	statistics.min_ns = ns_per_op.front();
+	statistics.mean_ns = sum / static_cast<double>(ns_per_op.size());
+	statistics.p50_ns = ns_per_op[last * 50U / 100U];
+	statistics.p90_ns = ns_per_op[last * 90U / 100U];
+	statistics.p99_ns = ns_per_op[last * 99U / 100U];
+	statistics.max_ns = ns_per_op.back();
+	return statistics;
+}
+
+/*
+Prints the statistics of benchmarks as a table, as CSV with a header line or as a JSON array of objects,
+so that the results of different releases can be compared by scripts.
+ops/s is computed from the median time per operation.
+*/
+class Reporter
+{
+public:
+	enum Format { text, csv, json };
+
+	explicit Reporter(Format format = text, FILE* file = stdout) : m_format(format), m_file(file), m_count(0U)
+	{
+		if (m_format == csv)
+			fprintf(m_file, "suite,name,operations,samples,min_ns,mean_ns,p50_ns,p90_ns,p99_ns,max_ns,ops_per_second\n");
+		else if (m_format == json)
+			fprintf(m_file, "[");
+		else
+			fprintf(m_file, "%-16s %-48s %10s %10s %10s %10s %14s\n", "suite", "name", "p50 ns/op", "p90 ns/op", "p99 ns/op", "max ns/op", "ops/s");
+	}
+
+	~Reporter()
+	{
+		if (m_format == json)
+			fprintf(m_file, "%s]\n", (m_count > 0U) ? "\n" : "");
+		fflush(m_file);
+	}
+
+	static bool parse_format(const char* text, Format& format)
+	{
+		if (strcmp(text, "text") == 0)
+			format = Reporter::text;
+		else if (strcmp(text, "csv") == 0)
+			format = Reporter::csv;
+		else if (strcmp(text, "json") == 0)
+			format = Reporter::json;
+		else
+			return false;
+		return true;
+	}
+
+	// The names must not contain quotes or commas.
+	void add(const char* suite, const char* name, const Statistics& statistics)
+	{
+		if (m_format == csv) {
+			fprintf(m_file, "%s,%s,%lu,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.0f\n", suite, name, static_cast<unsigned long>(statistics.operations),
+				statistics.samples, statistics.min_ns, statistics.mean_ns, statistics.p50_ns, statistics.p90_ns, statistics.p99_ns,
+				statistics.max_ns, statistics.ops_per_second());
+		} else if (m_format == json) {
+			fprintf(m_file, "%s\n  {\"suite\": \"%s\", \"name\": \"%s\", \"operations\": %lu, \"samples\": %d, \"min_ns\": %.3f, "
+				"\"mean_ns\": %.3f, \"p50_ns\": %.3f, \"p90_ns\": %.3f, \"p99_ns\": %.3f, \"max_ns\": %.3f, \"ops_per_second\": %.0f}",
+				(m_count > 0U) ? "," : "", suite, name, static_cast<unsigned long>(statistics.operations), statistics.samples,
+				statistics.min_ns, statistics.mean_ns, statistics.p50_ns, statistics.p90_ns, statistics.p99_ns, statistics.max_ns,
+				statistics.ops_per_second());
+		} else {
+			fprintf(m_file, "%-16s %-48s %10.2f %10.2f %10.2f %10.2f %14.0f\n", suite, name, statistics.p50_ns, statistics.p90_ns,
+				statistics.p99_ns, statistics.max_ns, statistics.ops_per_second());
+		}
+		fflush(m_file);
+		++m_count;
+	}
+
+private:
+	Reporter(const Reporter&);
+	Reporter& operator=(const Reporter&);
+
+	const Format m_format;
+	FILE* m_file;
+	size_t m_count;
+};
+
+} // namespace
+
+#endif
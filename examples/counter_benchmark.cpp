@@ -0,0 +1,137 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026 MH Lim
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// requires C++11
+
+// This program measures the cost of updating counters from several threads, with and without cache line padding and sharding.
+
+#include "res_mgr_atomic.hpp"
+#include "res_mgr_counter.hpp"
+#include "benchmark.hpp"
+
+#include <atomic>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+#define MAX_THREAD_COUNT 16
+
+// Counters on adjacent addresses, which share cache lines.
+typedef std::atomic<long> AdjacentCounter;
+typedef res_mgr::PaddedAtomic<long> PaddedCounter;
+typedef res_mgr::ShardedCounter<long> ShardedCounter;
+
+// Each thread increments its own counter, the operations are split evenly among the threads.
+template<class AtomicType>
+static void increment_own_counters(AtomicType* counters, size_t count, int thread_count)
+{
+	const size_t count_per_thread = count / static_cast<size_t>(thread_count);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < thread_count; ++t) {
+		threads.push_back(std::thread([counters, count_per_thread, t]() {
+			for (size_t i = 0U; i < count_per_thread; ++i)
+				res_mgr::atomic_increment<long, AtomicType>(&counters[t], res_mgr::memory_order_relaxed);
+		}));
+	}
+	for (size_t i = 0U; i < threads.size(); ++i)
+		threads[i].join();
+}
+
+template<class AtomicType>
+static void benchmark_own_counters(const char* counter_name, size_t count, int thread_count, int repetitions)
+{
+	char name[64];
+	AtomicType counters[MAX_THREAD_COUNT];
+	for (int t = 0; t < MAX_THREAD_COUNT; ++t)
+		res_mgr::atomic_store<long, AtomicType>(&counters[t], 0L, res_mgr::memory_order_relaxed);
+	const size_t operations = (count / static_cast<size_t>(thread_count)) * static_cast<size_t>(thread_count);
+	const double ns = benchmark::best_of(repetitions, [&counters, count, thread_count]() {
+		increment_own_counters(counters, count, thread_count);
+	});
+	snprintf(name, sizeof(name), "%s, %d thread(s)", counter_name, thread_count);
+	benchmark::report(name, ns, operations);
+
+	long total = 0L;
+	for (int t = 0; t < thread_count; ++t)
+		total += res_mgr::atomic_load<long, AtomicType>(&counters[t], res_mgr::memory_order_relaxed);
+	if (total != static_cast<long>(operations) * repetitions)
+		printf("Error: %s lost updates, the total is %ld\n", counter_name, total);
+}
+
+// All threads increment one counter, the operations are split evenly among the threads.
+template<class AtomicType>
+static void increment_shared_counter(AtomicType& counter, size_t count, int thread_count)
+{
+	const size_t count_per_thread = count / static_cast<size_t>(thread_count);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < thread_count; ++t) {
+		threads.push_back(std::thread([&counter, count_per_thread]() {
+			for (size_t i = 0U; i < count_per_thread; ++i)
+				res_mgr::atomic_increment<long, AtomicType>(&counter, res_mgr::memory_order_relaxed);
+		}));
+	}
+	for (size_t i = 0U; i < threads.size(); ++i)
+		threads[i].join();
+}
+
+template<class AtomicType>
+static void benchmark_shared_counter(const char* counter_name, size_t count, int thread_count, int repetitions)
+{
+	char name[64];
+	AtomicType counter(0L);
+	const size_t operations = (count / static_cast<size_t>(thread_count)) * static_cast<size_t>(thread_count);
+	const double ns = benchmark::best_of(repetitions, [&counter, count, thread_count]() {
+		increment_shared_counter(counter, count, thread_count);
+	});
+	snprintf(name, sizeof(name), "%s, %d thread(s)", counter_name, thread_count);
+	benchmark::report(name, ns, operations);
+
+	const long total = res_mgr::atomic_load<long, AtomicType>(&counter, res_mgr::memory_order_relaxed);
+	if (total != static_cast<long>(operations) * repetitions)
+		printf("Error: %s lost updates, the counter is %ld\n", counter_name, total);
+}
+
+int main(int argc, char *argv[])
+{
+	size_t count = 0U;
+	if (!benchmark::parse_count_argument(argc, argv, "iterations", 10000000U, count))
+		return 1;
+	const int repetitions = 5;
+	const int thread_counts[] = { 1, 4, MAX_THREAD_COUNT };
+
+	printf("Incrementing a counter per thread %lu times, best of %d runs\n", static_cast<unsigned long>(count), repetitions);
+	for (int thread_count : thread_counts) {
+		benchmark_own_counters<AdjacentCounter>("adjacent std::atomic", count, thread_count, repetitions);
+		benchmark_own_counters<PaddedCounter>("padded atomic", count, thread_count, repetitions);
+	}
+
+	printf("Incrementing one counter %lu times from several threads, best of %d runs\n", static_cast<unsigned long>(count), repetitions);
+	for (int thread_count : thread_counts) {
+		benchmark_shared_counter<AdjacentCounter>("std::atomic", count, thread_count, repetitions);
+		benchmark_shared_counter<PaddedCounter>("padded atomic", count, thread_count, repetitions);
+		benchmark_shared_counter<ShardedCounter>("sharded counter", count, thread_count, repetitions);
+	}
+	return 0;
+}
@@ -0,0 +1,272 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026 MH Lim
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// requires C++11
+
+#ifndef RESOURCE_MANAGER_HEX_FORMAT_HPP
+#define RESOURCE_MANAGER_HEX_FORMAT_HPP
+
+#include <stddef.h>
+#include <stdio.h>
+
+#if defined __x86_64__ || defined _M_X64
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#define HEX_FORMAT_HAS_SSE2
+#if defined __GNUC__ || defined __clang__
+#define HEX_FORMAT_HAS_SSSE3
+#define HEX_FORMAT_TARGET_SSSE3 __attribute__((target("ssse3")))
+#elif defined __AVX__
+#define HEX_FORMAT_HAS_SSSE3
+#define HEX_FORMAT_TARGET_SSSE3
+#endif
+#endif
+
+/*
+Formats binary data as lines of 32 bytes, each byte as 2 hexadecimal digits and a space, followed by 3 spaces and the bytes as ASCII characters.
+White space characters are printed as spaces and the characters that are not printable as '?', as isspace() and isprint() do in the C locale.
+The lines are separated by '\n', the last line is not terminated, an incomplete last line is padded so that its ASCII column is aligned.
+
+A line is formatted with lookup tables, or with SSSE3 shuffles on x86-64 processors that support them.
+The output is written to a buffer, print_binary_data() writes a block of lines with a single fwrite().
+*/
+namespace hex_format {
+
+const size_t bytes_per_line = 32U;
+const size_t line_length = bytes_per_line * 3U + 3U + bytes_per_line; // without the line break
+
+namespace detail {
+
+// Replaces the characters that isspace() or !isprint() would replace in the C locale.
+inline char to_ascii_column(unsigned char c)
+{
+	if (c == ' ' || (c >= '\t' && c <= '\r'))
+		return ' ';
+	return (c > ' ' && c < 0x7F) ? static_cast<char>(c) : '?';
+}
+
+struct Tables
+{
+	char hex[256][2];
+	char ascii[256];
+
+	Tables()
+	{
+		static const char digits[] = "0123456789ABCDEF";
+		for (int i = 0; i < 256; ++i) {
+			hex[i][0] = digits[i >> 4];
+			hex[i][1] = digits[i & 0x0F];
+			ascii[i] = to_ascii_column(static_cast<unsigned char>(i));
+		}
+	}
+};
+
+inline const Tables& get_tables()
+{
+	static const Tables tables;
+	return tables;
+}
+
+// Formats the hexadecimal column of number_of_bytes bytes, 3 characters per byte.
+inline void format_hex_scalar(const unsigned char* data, size_t number_of_bytes, char* out)
+{
+	const Tables& tables = get_tables();
+	for (size_t i = 0U; i < number_of_bytes; ++i) {
+		out[3 * i] = tables.hex[data[i]][0];
+		out[3 * i + 1] = tables.hex[data[i]][1];
+		out[3 * i + 2] = ' ';
+	}
+}
+
+inline void format_ascii_scalar(const unsigned char* data, size_t number_of_bytes, char* out)
+{
+	const Tables& tables = get_tables();
+	for (size_t i = 0U; i < number_of_bytes; ++i)
+		out[i] = tables.ascii[data[i]];
+}
+
+#ifdef HEX_FORMAT_HAS_SSE2
+// Formats the ASCII column of 16 bytes.
+inline void format_ascii_sse2(const unsigned char* data, char* out)
+{
+	const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+	// The comparisons are signed, so the bytes from 0x80 are neither printable nor white space.
+	const __m128i printable = _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8(' ')), _mm_cmplt_epi8(bytes, _mm_set1_epi8(0x7F)));
+	const __m128i space = _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')),
+		_mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8('\t' - 1)), _mm_cmplt_epi8(bytes, _mm_set1_epi8('\r' + 1))));
+	const __m128i replaced = _mm_or_si128(_mm_and_si128(space, _mm_set1_epi8(' ')), _mm_andnot_si128(space, _mm_set1_epi8('?')));
+	const __m128i result = _mm_or_si128(_mm_and_si128(printable, bytes), _mm_andnot_si128(printable, replaced));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(out), result);
+}
+#endif
+
+#ifdef HEX_FORMAT_HAS_SSSE3
+/*
+Formats the hexadecimal column of 16 bytes, 48 characters.
+The digits are looked up by nibble with a shuffle, interleaved into pairs and shuffled again into groups of 3 characters.
+*/
+HEX_FORMAT_TARGET_SSSE3 inline void format_hex_ssse3(const unsigned char* data, char* out)
+{
+	const __m128i digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F');
+	const __m128i low_nibble = _mm_set1_epi8(0x0F);
+	const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+	const __m128i high = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(bytes, 4), low_nibble));
+	const __m128i low = _mm_shuffle_epi8(digits, _mm_and_si128(bytes, low_nibble));
+	const __m128i pairs0 = _mm_unpacklo_epi8(high, low); // the digits of bytes 0 to 7
+	const __m128i pairs1 = _mm_unpackhi_epi8(high, low); // the digits of bytes 8 to 15
+
+	// An index of -1 gives 0, the spaces are added afterwards.
+	const __m128i out0 = _mm_or_si128(
+		_mm_shuffle_epi8(pairs0, _mm_setr_epi8(0, 1, -1, 2, 3, -1, 4, 5, -1, 6, 7, -1, 8, 9, -1, 10)),
+		_mm_setr_epi8(0, 0, ' ', 0, 0, ' ', 0, 0, ' ', 0, 0, ' ', 0, 0, ' ', 0));
+	const __m128i out1 = _mm_or_si128(_mm_or_si128(
+		_mm_shuffle_epi8(pairs0, _mm_setr_epi8(11, -1, 12, 13, -1, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1)),
+		_mm_shuffle_epi8(pairs1, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, 0, 1, -1, 2, 3, -1, 4, 5))),
+		_mm_setr_epi8(0, ' ', 0, 0, ' ', 0, 0, ' ', 0, 0, ' ', 0, 0, ' ', 0, 0));
+	const __m128i out2 = _mm_or_si128(
+		_mm_shuffle_epi8(pairs1, _mm_setr_epi8(-1, 6, 7, -1, 8, 9, -1, 10, 11, -1, 12, 13, -1, 14, 15, -1)),
+		_mm_setr_epi8(' ', 0, 0, ' ', 0, 0, ' ', 0, 0, ' ', 0, 0, ' ', 0, 0, ' '));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(out), out0);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), out1);
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 32), out2);
+}
+
+HEX_FORMAT_TARGET_SSSE3 inline void format_line_ssse3(const unsigned char* data, char* out)
+{
+	format_hex_ssse3(data, out);
+	format_hex_ssse3(data + 16, out + 48);
+	out[96] = ' ';
+	out[97] = ' ';
+	out[98] = ' ';
+	format_ascii_sse2(data, out + 99);
+	format_ascii_sse2(data + 16, out + 115);
+}
+#endif
+
+inline void format_line_scalar(const unsigned char* data, char* out)
+{
+	format_hex_scalar(data, bytes_per_line, out);
+	out[96] = ' ';
+	out[97] = ' ';
+	out[98] = ' ';
+#ifdef HEX_FORMAT_HAS_SSE2
+	format_ascii_sse2(data, out + 99);
+	format_ascii_sse2(data + 16, out + 115);
+#else
+	format_ascii_scalar(data, bytes_per_line, out + 99);
+#endif
+}
+
+typedef void (*LineFormatter)(const unsigned char* data, char* out);
+
+inline LineFormatter select_line_formatter()
+{
+#if defined HEX_FORMAT_HAS_SSSE3 && (defined __GNUC__ || defined __clang__)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("ssse3"))
+		return &format_line_ssse3;
+	return &format_line_scalar;
+#elif defined HEX_FORMAT_HAS_SSSE3
+	return &format_line_ssse3;
+#else
+	return &format_line_scalar;
+#endif
+}
+
+} // namespace detail
+
+// Formats a complete line of bytes_per_line bytes, line_length characters without a line break.
+inline void format_line(const unsigned char* data, char* out)
+{
+	static const detail::LineFormatter formatter = detail::select_line_formatter();
+	formatter(data, out);
+}
+
+// Formats an incomplete last line of fewer than bytes_per_line bytes, returns the number of characters written.
+inline size_t format_last_line(const unsigned char* data, size_t number_of_bytes, char* out)
+{
+	detail::format_hex_scalar(data, number_of_bytes, out);
+	char* p = out + 3U * number_of_bytes;
+	for (size_t i = number_of_bytes; i < bytes_per_line + 1U; ++i) {
+		*p++ = ' ';
+		*p++ = ' ';
+		*p++ = ' ';
+	}
+	detail::format_ascii_scalar(data, number_of_bytes, p);
+	return static_cast<size_t>(p - out) + number_of_bytes;
+}
+
+// Returns the number of characters that format_binary_data writes for number_of_bytes bytes.
+inline size_t get_formatted_size(size_t number_of_bytes)
+{
+	const size_t number_of_lines = number_of_bytes / bytes_per_line;
+	const size_t remaining_bytes = number_of_bytes % bytes_per_line;
+	size_t size = number_of_lines * (line_length + 1U);
+	if (remaining_bytes > 0U)
+		size += line_length - bytes_per_line + remaining_bytes;
+	else if (number_of_lines > 0U)
+		size -= 1U; // the last line is not terminated
+	return size;
+}
+
+// Formats the data into out, which must hold get_formatted_size(number_of_bytes) characters, returns the number of characters written.
+inline size_t format_binary_data(const unsigned char* data, size_t number_of_bytes, char* out)
+{
+	const size_t number_of_lines = number_of_bytes / bytes_per_line;
+	const size_t remaining_bytes = number_of_bytes % bytes_per_line;
+	char* p = out;
+	for (size_t i = 0U; i < number_of_lines; ++i) {
+		if (i > 0U)
+			*p++ = '\n';
+		format_line(data + i * bytes_per_line, p);
+		p += line_length;
+	}
+	if (remaining_bytes > 0U) {
+		if (number_of_lines > 0U)
+			*p++ = '\n';
+		p += format_last_line(data + number_of_lines * bytes_per_line, remaining_bytes, p);
+	}
+	return static_cast<size_t>(p - out);
+}
+
+// Formats the data in blocks of lines and writes each block with a single fwrite().
+inline void print_binary_data(FILE* file, const unsigned char* data, size_t number_of_bytes)
+{
+	const size_t lines_per_block = 256U;
+	const size_t bytes_per_block = lines_per_block * bytes_per_line;
+	char buffer[lines_per_block * (line_length + 1U)];
+	for (size_t offset = 0U; offset < number_of_bytes; offset += bytes_per_block) {
+		const size_t remaining_bytes = number_of_bytes - offset;
+		const size_t block_size = (remaining_bytes < bytes_per_block) ? remaining_bytes : bytes_per_block;
+		size_t size = 0U;
+		if (offset > 0U)
+			buffer[size++] = '\n';
+		size += format_binary_data(data + offset, block_size, buffer + size);
+		fwrite(buffer, 1U, size, file);
+	}
+}
+
+} // namespace
+
+#endif
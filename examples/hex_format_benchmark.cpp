@@ -0,0 +1,206 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026 MH Lim
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// requires C++11
+
+// This program checks that hex_format prints the same output as the printf based formatter it replaces and measures both.
+
+#include "hex_format.hpp"
+#include "benchmark.hpp"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+// The formatter used by binary_file_viewer before hex_format, one fprintf() per byte.
+static void print_binary_data_printf(FILE *file, const unsigned char* data, size_t number_of_bytes)
+{
+	const size_t bytes_per_line = 32U;
+	const size_t number_of_lines = number_of_bytes / bytes_per_line;
+	const size_t remaining_bytes = number_of_bytes % bytes_per_line;
+
+	for (size_t i = 0U; i < number_of_lines; ++i) {
+		const size_t offset = i * bytes_per_line;
+		for (size_t j = 0U; j < bytes_per_line; ++j) {
+			const size_t index = offset + j;
+			fprintf(file, "%02X ", data[index]);
+		}
+		fprintf(file, "   ");
+		for (size_t j = 0U; j < bytes_per_line; ++j) {
+			const size_t index = offset + j;
+			unsigned char c = data[index];
+			if (isspace(c)) {
+				c = ' ';
+			} else if (!isprint(c)) {
+				c = '?';
+			}
+			fputc(c, file);
+		}
+		if ((i + 1) < number_of_lines || remaining_bytes > 0U)
+			fputc('\n', file);
+	}
+
+	if (remaining_bytes > 0U) {
+		const size_t offset = bytes_per_line * number_of_lines;
+		for (size_t i = 0U; i < remaining_bytes; ++i) {
+			const size_t index = offset + i;
+			fprintf(file, "%02X ", data[index]);
+		}
+		for (size_t i = remaining_bytes; i < bytes_per_line; ++i) {
+			fprintf(file, "   ");
+		}
+		fprintf(file, "   ");
+		for (size_t i = 0U; i < remaining_bytes; ++i) {
+			const size_t index = offset + i;
+			unsigned char c = data[index];
+			if (isspace(c)) {
+				c = ' ';
+			}
+			else if (!isprint(c)) {
+				c = '?';
+			}
+			fputc(c, file);
+		}
+	}
+}
+
+typedef void (*PrintFunction)(FILE* file, const unsigned char* data, size_t number_of_bytes);
+
+// Returns the output of the print function.
+static std::string capture(PrintFunction print, const unsigned char* data, size_t number_of_bytes)
+{
+	std::string output;
+	FILE* file = tmpfile();
+	if (file == NULL)
+		return output;
+	print(file, data, number_of_bytes);
+	const long size = ftell(file);
+	rewind(file);
+	output.resize(static_cast<size_t>(size));
+	if (size > 0 && fread(&output[0], 1U, output.size(), file) != output.size())
+		output.clear();
+	fclose(file);
+	return output;
+}
+
+// Compares the outputs for every size up to a few lines, for a block boundary and for every byte value,
+// as far as the data reaches.
+static bool check_output(const std::vector<unsigned char>& data)
+{
+	const size_t check_sizes[] = { 256U * hex_format::bytes_per_line, 256U * hex_format::bytes_per_line + 7U, data.size() };
+	std::vector<size_t> sizes;
+	for (size_t size = 0U; size <= 4U * hex_format::bytes_per_line + 1U && size <= data.size(); ++size)
+		sizes.push_back(size);
+	for (size_t size : check_sizes) {
+		if (size <= data.size())
+			sizes.push_back(size);
+	}
+
+	for (size_t i = 0U; i < sizes.size(); ++i) {
+		const std::string expected = capture(&print_binary_data_printf, data.data(), sizes[i]);
+		const std::string actual = capture(&hex_format::print_binary_data, data.data(), sizes[i]);
+		if (actual != expected) {
+			printf("Error: the output differs for %lu bytes\n", static_cast<unsigned long>(sizes[i]));
+			return false;
+		}
+		std::vector<char> buffer(hex_format::get_formatted_size(sizes[i]) + 1U);
+		const size_t size = hex_format::format_binary_data(data.data(), sizes[i], buffer.data());
+		if (size != hex_format::get_formatted_size(sizes[i]) || std::string(buffer.data(), size) != expected) {
+			printf("Error: the formatted data differs for %lu bytes\n", static_cast<unsigned long>(sizes[i]));
+			return false;
+		}
+	}
+	return true;
+}
+
+static void benchmark_print(const char* name, PrintFunction print, FILE* file, const std::vector<unsigned char>& data, int repetitions)
+{
+	const double ns = benchmark::best_of(repetitions, [print, file, &data]() {
+		print(file, data.data(), data.size());
+		fflush(file);
+	});
+	char line[80];
+	snprintf(line, sizeof(line), "%s, %.1f MB/s", name, (ns > 0.0) ? (static_cast<double>(data.size()) * 1e3 / ns) : 0.0);
+	benchmark::report(line, ns, data.size());
+}
+
+static void benchmark_line_formatter(const char* name, hex_format::detail::LineFormatter format_line, const std::vector<unsigned char>& data, int repetitions)
+{
+	const size_t number_of_lines = data.size() / hex_format::bytes_per_line;
+	std::vector<char> buffer(hex_format::line_length);
+	const double ns = benchmark::best_of(repetitions, [format_line, number_of_lines, &data, &buffer]() {
+		for (size_t i = 0U; i < number_of_lines; ++i) {
+			format_line(data.data() + i * hex_format::bytes_per_line, buffer.data());
+			benchmark::do_not_optimize(buffer[0]);
+		}
+	});
+	char line[80];
+	snprintf(line, sizeof(line), "%s, %.1f MB/s", name, (ns > 0.0) ? (static_cast<double>(number_of_lines * hex_format::bytes_per_line) * 1e3 / ns) : 0.0);
+	benchmark::report(line, ns, number_of_lines * hex_format::bytes_per_line);
+}
+
+int main(int argc, char *argv[])
+{
+	size_t size = 0U;
+	if (!benchmark::parse_count_argument(argc, argv, "bytes", 16U * 1024U * 1024U, size))
+		return 1;
+	const int repetitions = 5;
+
+	std::vector<unsigned char> data(size);
+	unsigned int seed = 12345U;
+	for (size_t i = 0U; i < data.size(); ++i) {
+		seed = seed * 1103515245U + 12345U;
+		data[i] = static_cast<unsigned char>((i < 256U) ? i : (seed >> 16));
+	}
+
+	if (!check_output(data))
+		return 1;
+	printf("The output is the same as the output of the printf formatter\n");
+
+#if defined _WIN32 || defined _WIN64
+	FILE* null_file = fopen("NUL", "wb");
+#else
+	FILE* null_file = fopen("/dev/null", "wb");
+#endif
+	if (null_file == NULL) {
+		printf("Error: cannot open the null device\n");
+		return 1;
+	}
+
+	printf("Formatting %lu bytes, best of %d runs, ns per byte\n", static_cast<unsigned long>(size), repetitions);
+	benchmark_line_formatter("lookup tables", &hex_format::detail::format_line_scalar, data, repetitions);
+#ifdef HEX_FORMAT_HAS_SSSE3
+	if (hex_format::detail::select_line_formatter() == &hex_format::detail::format_line_ssse3)
+		benchmark_line_formatter("SSSE3", &hex_format::detail::format_line_ssse3, data, repetitions);
+#endif
+
+	printf("Printing %lu bytes to the null device, best of %d runs, ns per byte\n", static_cast<unsigned long>(size), repetitions);
+	benchmark_print("fprintf per byte", &print_binary_data_printf, null_file, data, repetitions);
+	benchmark_print("hex_format, fwrite per block", &hex_format::print_binary_data, null_file, data, repetitions);
+	fclose(null_file);
+	return 0;
+}
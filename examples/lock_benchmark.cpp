@@ -0,0 +1,377 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026 MH Lim
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// requires C++11
+
+// This program measures the cost of locking and unlocking the locks managed by ResourceLock.
+
+#include "res_mgr_lock.hpp"
+#include "res_mgr_lock_profile.hpp"
+#include "res_mgr_rwlock.hpp"
+#include "res_mgr_spinlock.hpp"
+#include "mutex.h"
+#include "benchmark.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+struct HeapMutexInitFunctor {
+	void operator()(void* &mutex) {
+		mutex = mutex_create();
+	}
+};
+
+struct HeapMutexDeinitFunctor {
+	void operator()(void *mutex) {
+		mutex_destroy(mutex);
+	}
+};
+
+struct HeapMutexLockFunctor {
+	void operator()(void *mutex) {
+		mutex_lock(mutex);
+	}
+
+	bool operator()(void *mutex, unsigned long timeout_ms) {
+		return 0 == ((timeout_ms == 0UL) ? mutex_trylock(mutex) : mutex_timedlock(mutex, timeout_ms));
+	}
+};
+
+struct HeapMutexUnlockFunctor {
+	void operator()(void *mutex) {
+		mutex_unlock(mutex);
+	}
+};
+
+struct InlineMutexInitFunctor {
+	void operator()(mutex_storage_t &mutex) {
+		mutex_init(&mutex);
+	}
+};
+
+struct InlineMutexDeinitFunctor {
+	void operator()(mutex_storage_t &mutex) {
+		mutex_deinit(&mutex);
+	}
+};
+
+struct InlineMutexLockFunctor {
+	void operator()(mutex_storage_t &mutex) {
+		mutex_storage_lock(&mutex);
+	}
+
+	bool operator()(mutex_storage_t &mutex, unsigned long timeout_ms) {
+		return 0 == ((timeout_ms == 0UL) ? mutex_storage_trylock(&mutex) : mutex_storage_timedlock(&mutex, timeout_ms));
+	}
+};
+
+struct InlineMutexUnlockFunctor {
+	void operator()(mutex_storage_t &mutex) {
+		mutex_storage_unlock(&mutex);
+	}
+};
+
+struct RWLockInitFunctor {
+	void operator()(rwlock_storage_t &rwlock) {
+		rwlock_init(&rwlock);
+	}
+};
+
+struct RWLockDeinitFunctor {
+	void operator()(rwlock_storage_t &rwlock) {
+		rwlock_deinit(&rwlock);
+	}
+};
+
+struct RWLockLockFunctor {
+	void operator()(rwlock_storage_t &rwlock) {
+		rwlock_lock(&rwlock);
+	}
+};
+
+struct RWLockUnlockFunctor {
+	void operator()(rwlock_storage_t &rwlock) {
+		rwlock_unlock(&rwlock);
+	}
+};
+
+struct RWLockLockSharedFunctor {
+	void operator()(rwlock_storage_t &rwlock) {
+		rwlock_lock_shared(&rwlock);
+	}
+};
+
+struct RWLockUnlockSharedFunctor {
+	void operator()(rwlock_storage_t &rwlock) {
+		rwlock_unlock_shared(&rwlock);
+	}
+};
+
+typedef res_mgr::ResourceLock<void*, HeapMutexInitFunctor, HeapMutexDeinitFunctor, HeapMutexLockFunctor, HeapMutexUnlockFunctor> HeapMutex;
+typedef res_mgr::ResourceLock<mutex_storage_t, InlineMutexInitFunctor, InlineMutexDeinitFunctor, InlineMutexLockFunctor, InlineMutexUnlockFunctor> InlineMutex;
+typedef res_mgr::ResourceSharedLock<rwlock_storage_t, RWLockInitFunctor, RWLockDeinitFunctor, RWLockLockFunctor, RWLockUnlockFunctor,
+	RWLockLockSharedFunctor, RWLockUnlockSharedFunctor> RWLock;
+
+// A counter guarded by its own mutex, e.g. a bucket of a hash table.
+template<class MutexType>
+struct GuardedCounter
+{
+	MutexType mutex;
+	unsigned long value;
+
+	GuardedCounter() : value(0UL)
+	{
+	}
+
+	explicit GuardedCounter(const char* name) : mutex(name), value(0UL)
+	{
+	}
+};
+
+// Increments counters in a pseudo-random order, so that the mutexes are rarely in the cache.
+template<class MutexType>
+static void lock_and_increment(std::vector<GuardedCounter<MutexType>>& counters, size_t count)
+{
+	unsigned int index = 1U;
+	for (size_t i = 0U; i < count; ++i) {
+		index = index * 1103515245U + 12345U;
+		GuardedCounter<MutexType>& counter = counters[index % counters.size()];
+		res_mgr::ResourceLockMechanism<MutexType> lock(counter.mutex);
+		++counter.value;
+	}
+	benchmark::do_not_optimize(counters[0].value);
+}
+
+template<class MutexType>
+static void benchmark_mutex(const char* mutex_name, size_t count, size_t number_of_counters, int repetitions)
+{
+	char name[64];
+	std::vector<GuardedCounter<MutexType>> counters(number_of_counters);
+	const double ns = benchmark::best_of(repetitions, [&counters, count]() { lock_and_increment(counters, count); });
+	snprintf(name, sizeof(name), "%s, %lu counters", mutex_name, static_cast<unsigned long>(number_of_counters));
+	benchmark::report(name, ns, count);
+}
+
+// All threads increment one counter, the operations are split evenly among the threads.
+template<class MutexType>
+static void lock_and_increment_concurrently(GuardedCounter<MutexType>& counter, size_t count, int thread_count)
+{
+	const size_t count_per_thread = count / static_cast<size_t>(thread_count);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < thread_count; ++t) {
+		threads.push_back(std::thread([&counter, count_per_thread]() {
+			for (size_t i = 0U; i < count_per_thread; ++i) {
+				res_mgr::ResourceLockMechanism<MutexType> lock(counter.mutex);
+				++counter.value;
+			}
+		}));
+	}
+	for (size_t i = 0U; i < threads.size(); ++i)
+		threads[i].join();
+}
+
+template<class MutexType>
+static void benchmark_contended_mutex(const char* mutex_name, size_t count, int thread_count, int repetitions)
+{
+	char name[64];
+	GuardedCounter<MutexType> counter;
+	const size_t operations = (count / static_cast<size_t>(thread_count)) * static_cast<size_t>(thread_count);
+	const double ns = benchmark::best_of(repetitions, [&counter, count, thread_count]() {
+		lock_and_increment_concurrently(counter, count, thread_count);
+	});
+	snprintf(name, sizeof(name), "%s, %d thread(s)", mutex_name, thread_count);
+	benchmark::report(name, ns, operations);
+	if (counter.value != operations * static_cast<size_t>(repetitions))
+		printf("Error: %s lost updates, the counter is %lu\n", mutex_name, counter.value);
+}
+
+typedef res_mgr::ProfiledLock<res_mgr::SpinLock> ProfiledSpinLock;
+
+static void benchmark_profiled_lock(size_t count, int thread_count, int repetitions)
+{
+	char name[64];
+	GuardedCounter<ProfiledSpinLock> counter("counter lock");
+	const size_t operations = (count / static_cast<size_t>(thread_count)) * static_cast<size_t>(thread_count);
+	const double ns = benchmark::best_of(repetitions, [&counter, count, thread_count]() {
+		lock_and_increment_concurrently(counter, count, thread_count);
+	});
+	snprintf(name, sizeof(name), "profiled TTAS spinlock, %d thread(s)", thread_count);
+	benchmark::report(name, ns, operations);
+#ifdef RES_MGR_LOCK_PROFILING
+	printf("%s", counter.mutex.get_stats().to_text().c_str());
+#endif
+}
+
+// All threads read the counter, one operation in every 1000 increments it.
+template<class SharedLockType>
+static void read_mostly_concurrently(GuardedCounter<SharedLockType>& counter, size_t count, int thread_count)
+{
+	const size_t count_per_thread = count / static_cast<size_t>(thread_count);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < thread_count; ++t) {
+		threads.push_back(std::thread([&counter, count_per_thread]() {
+			for (size_t i = 0U; i < count_per_thread; ++i) {
+				if (i % 1000U == 999U) {
+					res_mgr::ResourceLockMechanism<SharedLockType> lock(counter.mutex);
+					++counter.value;
+				} else {
+					res_mgr::SharedLockMechanism<SharedLockType> lock(counter.mutex);
+					benchmark::do_not_optimize(counter.value);
+				}
+			}
+		}));
+	}
+	for (size_t i = 0U; i < threads.size(); ++i)
+		threads[i].join();
+}
+
+template<class SharedLockType>
+static void benchmark_shared_lock(const char* lock_name, size_t count, int thread_count, int repetitions)
+{
+	char name[64];
+	GuardedCounter<SharedLockType> counter;
+	const size_t count_per_thread = count / static_cast<size_t>(thread_count);
+	const size_t operations = count_per_thread * static_cast<size_t>(thread_count);
+	const double ns = benchmark::best_of(repetitions, [&counter, count, thread_count]() {
+		read_mostly_concurrently(counter, count, thread_count);
+	});
+	snprintf(name, sizeof(name), "%s, %d thread(s)", lock_name, thread_count);
+	benchmark::report(name, ns, operations);
+	if (counter.value != (count_per_thread / 1000U) * static_cast<size_t>(thread_count) * static_cast<size_t>(repetitions))
+		printf("Error: %s lost updates, the counter is %lu\n", lock_name, counter.value);
+}
+
+struct Account
+{
+	InlineMutex mutex;
+	long balance;
+
+	Account() : balance(1000L)
+	{
+	}
+};
+
+// Every thread moves money between two random accounts, either under one global lock or under the locks of the two accounts.
+static void transfer_concurrently(std::vector<Account>& accounts, InlineMutex* global_mutex, size_t count, int thread_count)
+{
+	const size_t count_per_thread = count / static_cast<size_t>(thread_count);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < thread_count; ++t) {
+		threads.push_back(std::thread([&accounts, global_mutex, count_per_thread, t]() {
+			unsigned int index = static_cast<unsigned int>(t) + 1U;
+			for (size_t i = 0U; i < count_per_thread; ++i) {
+				index = index * 1103515245U + 12345U;
+				Account& from = accounts[(index >> 8) % accounts.size()];
+				Account& to = accounts[((index >> 8) + 1U + (index >> 24) % (accounts.size() - 1U)) % accounts.size()];
+				if (global_mutex != NULL) {
+					res_mgr::ResourceLockMechanism<InlineMutex> lock(*global_mutex);
+					--from.balance;
+					++to.balance;
+				} else {
+					res_mgr::ScopedMultiLock<InlineMutex, InlineMutex> lock(from.mutex, to.mutex);
+					--from.balance;
+					++to.balance;
+				}
+			}
+		}));
+	}
+	for (size_t i = 0U; i < threads.size(); ++i)
+		threads[i].join();
+}
+
+static void benchmark_transfer(size_t count, int thread_count, int repetitions)
+{
+	char name[64];
+	const size_t number_of_accounts = 64U;
+	const size_t operations = (count / static_cast<size_t>(thread_count)) * static_cast<size_t>(thread_count);
+	InlineMutex global_mutex;
+	InlineMutex* mutexes[] = { &global_mutex, NULL };
+	const char* names[] = { "global mutex", "ScopedMultiLock" };
+	for (size_t m = 0U; m < 2U; ++m) {
+		std::vector<Account> accounts(number_of_accounts);
+		InlineMutex* mutex = mutexes[m];
+		const double ns = benchmark::best_of(repetitions, [&accounts, mutex, count, thread_count]() {
+			transfer_concurrently(accounts, mutex, count, thread_count);
+		});
+		snprintf(name, sizeof(name), "%s, %d thread(s)", names[m], thread_count);
+		benchmark::report(name, ns, operations);
+
+		long total = 0L;
+		for (size_t i = 0U; i < accounts.size(); ++i)
+			total += accounts[i].balance;
+		if (total != 1000L * static_cast<long>(number_of_accounts))
+			printf("Error: %s lost updates, the total balance is %ld\n", names[m], total);
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	size_t count = 0U;
+	if (!benchmark::parse_count_argument(argc, argv, "iterations", 1000000U, count))
+		return 1;
+	const int repetitions = 5;
+	const size_t counter_counts[] = { 1U, 1024U, 262144U };
+
+	printf("Locking a mutex, incrementing a counter and unlocking the mutex %lu times, best of %d runs\n",
+		static_cast<unsigned long>(count), repetitions);
+	for (size_t number_of_counters : counter_counts) {
+		benchmark_mutex<HeapMutex>("heap allocated mutex", count, number_of_counters, repetitions);
+		benchmark_mutex<InlineMutex>("inline mutex", count, number_of_counters, repetitions);
+	}
+
+	const int thread_counts[] = { 1, 4 };
+	printf("Incrementing one counter %lu times from several threads, best of %d runs\n", static_cast<unsigned long>(count), repetitions);
+	for (int thread_count : thread_counts) {
+		benchmark_contended_mutex<InlineMutex>("inline mutex", count, thread_count, repetitions);
+		benchmark_contended_mutex<res_mgr::SpinLock>("TTAS spinlock", count, thread_count, repetitions);
+		benchmark_contended_mutex<res_mgr::TicketLock>("ticket lock", count, thread_count, repetitions);
+		benchmark_contended_mutex<res_mgr::AdaptiveLock>("adaptive lock", count, thread_count, repetitions);
+	}
+
+#ifdef RES_MGR_LOCK_PROFILING
+	printf("Incrementing one counter %lu times from several threads with lock profiling, best of %d runs\n",
+		static_cast<unsigned long>(count), repetitions);
+#else
+	printf("Incrementing one counter %lu times from several threads, lock profiling compiled out, best of %d runs\n",
+		static_cast<unsigned long>(count), repetitions);
+#endif
+	for (int thread_count : thread_counts)
+		benchmark_profiled_lock(count, thread_count, repetitions);
+
+	const int reader_thread_counts[] = { 1, 4, 16 };
+	printf("Reading a counter %lu times from several threads, 0.1%% of the operations write, best of %d runs\n",
+		static_cast<unsigned long>(count), repetitions);
+	for (int thread_count : reader_thread_counts) {
+		benchmark_shared_lock<RWLock>("inline reader-writer lock", count, thread_count, repetitions);
+		benchmark_shared_lock<res_mgr::ReaderBiasedLock>("reader-biased lock", count, thread_count, repetitions);
+	}
+
+	printf("Transferring between two of 64 accounts %lu times from several threads, best of %d runs\n",
+		static_cast<unsigned long>(count), repetitions);
+	for (int thread_count : thread_counts)
+		benchmark_transfer(count, thread_count, repetitions);
+	return 0;
+}
@@ -22,15 +22,43 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+/* Declares pthread_mutex_clocklock in glibc, see posix_mutex_timedlock */
+#if defined __linux__ && !defined _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
 #include "mutex.h"
 #include <stdlib.h>
 
 #if defined _WIN32 || defined _WIN64
 #include <Windows.h>
 #else
+#include <errno.h>
 #include <pthread.h>
+#include <time.h>
+#include <unistd.h>
 #endif
 
+#if defined _WIN32 || defined _WIN64
+#ifdef MUTEX_USE_WINDOWS_MUTEX
+typedef HANDLE native_mutex_type;
+#else
+typedef CRITICAL_SECTION native_mutex_type;
+#endif
+#else
+typedef pthread_mutex_t native_mutex_type;
+#endif
+
+#if defined _WIN32 || defined _WIN64
+typedef SRWLOCK native_rwlock_type;
+#else
+typedef pthread_rwlock_t native_rwlock_type;
+#endif
+
+/* fail to compile if the storage cannot hold the native lock */
+typedef char mutex_storage_size_check[(sizeof(native_mutex_type) <= sizeof(mutex_storage_t)) ? 1 : -1];
+typedef char rwlock_storage_size_check[(sizeof(native_rwlock_type) <= sizeof(rwlock_storage_t)) ? 1 : -1];
+
 #if defined _WIN32 || defined _WIN64
 
 static void *windows_mutex_create()
@@ -84,6 +112,68 @@ static int windows_mutex_unlock(void *mutex)
 #endif
 }
 
+static int windows_mutex_timedlock(void *mutex, unsigned long milliseconds)
+{
+#ifdef MUTEX_USE_WINDOWS_MUTEX
+	HANDLE m = (HANDLE) mutex;
+	return (WaitForSingleObject(m, milliseconds) == WAIT_OBJECT_0) ? 0 : -1;
+#else
+	/* a critical section cannot be waited for with a timeout, poll it */
+	CRITICAL_SECTION *m = (CRITICAL_SECTION*) mutex;
+	const ULONGLONG deadline = GetTickCount64() + milliseconds;
+	while (!TryEnterCriticalSection(m)) {
+		if (GetTickCount64() >= deadline)
+			return -1;
+		Sleep(1);
+	}
+	return 0;
+#endif
+}
+
+#else
+
+#if defined __GLIBC__ && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 30))
+#define MUTEX_HAS_CLOCKLOCK 1
+#endif
+
+#if defined MUTEX_HAS_CLOCKLOCK || (defined _POSIX_TIMEOUTS && _POSIX_TIMEOUTS > 0)
+static struct timespec get_deadline(clockid_t clock_id, unsigned long milliseconds)
+{
+	struct timespec deadline;
+	clock_gettime(clock_id, &deadline);
+	deadline.tv_sec += (time_t) (milliseconds / 1000UL);
+	deadline.tv_nsec += (long) (milliseconds % 1000UL) * 1000000L;
+	if (deadline.tv_nsec >= 1000000000L) {
+		deadline.tv_sec += 1;
+		deadline.tv_nsec -= 1000000000L;
+	}
+	return deadline;
+}
+#endif
+
+static int posix_mutex_timedlock(pthread_mutex_t *m, unsigned long milliseconds)
+{
+#if defined MUTEX_HAS_CLOCKLOCK
+	/* the deadline is measured on CLOCK_MONOTONIC, so that changing the system time does not change the timeout */
+	const struct timespec deadline = get_deadline(CLOCK_MONOTONIC, milliseconds);
+	return pthread_mutex_clocklock(m, CLOCK_MONOTONIC, &deadline);
+#elif defined _POSIX_TIMEOUTS && _POSIX_TIMEOUTS > 0
+	/* pthread_mutex_timedlock only accepts a CLOCK_REALTIME deadline, the timeout changes if the system time is changed while waiting */
+	const struct timespec deadline = get_deadline(CLOCK_REALTIME, milliseconds);
+	return pthread_mutex_timedlock(m, &deadline);
+#else
+	/* pthread_mutex_timedlock is not available (e.g. macOS), poll the mutex every millisecond */
+	const struct timespec interval = { 0, 1000000L };
+	int result;
+	while ((result = pthread_mutex_trylock(m)) == EBUSY) {
+		if (milliseconds-- == 0UL)
+			return ETIMEDOUT;
+		nanosleep(&interval, NULL);
+	}
+	return result;
+#endif
+}
+
 #endif /* #if defined _WIN32 || defined _WIN64 */
 
 void *mutex_create()
@@ -131,3 +221,161 @@ int mutex_unlock(void *mutex)
 	return pthread_mutex_unlock(m);
 #endif
 }
+
+int mutex_trylock(void *mutex)
+{
+#if defined _WIN32 || defined _WIN64
+	return windows_mutex_timedlock(mutex, 0UL);
+#else
+	pthread_mutex_t *m = (pthread_mutex_t*) mutex;
+	return pthread_mutex_trylock(m);
+#endif
+}
+
+int mutex_timedlock(void *mutex, unsigned long milliseconds)
+{
+#if defined _WIN32 || defined _WIN64
+	return windows_mutex_timedlock(mutex, milliseconds);
+#else
+	pthread_mutex_t *m = (pthread_mutex_t*) mutex;
+	return posix_mutex_timedlock(m, milliseconds);
+#endif
+}
+
+int mutex_init(mutex_storage_t *mutex)
+{
+#if defined _WIN32 || defined _WIN64
+#ifdef MUTEX_USE_WINDOWS_MUTEX
+	HANDLE *m = (HANDLE*) mutex->bytes;
+	*m = CreateMutex(NULL, FALSE, NULL);
+	return (*m != NULL) ? 0 : -1;
+#else
+	InitializeCriticalSection((CRITICAL_SECTION*) mutex->bytes);
+	return 0;
+#endif
+#else
+	return pthread_mutex_init((pthread_mutex_t*) mutex->bytes, NULL);
+#endif
+}
+
+void mutex_deinit(mutex_storage_t *mutex)
+{
+#if defined _WIN32 || defined _WIN64
+#ifdef MUTEX_USE_WINDOWS_MUTEX
+	HANDLE m = *(HANDLE*) mutex->bytes;
+	if (m)
+		CloseHandle(m);
+#else
+	DeleteCriticalSection((CRITICAL_SECTION*) mutex->bytes);
+#endif
+#else
+	pthread_mutex_destroy((pthread_mutex_t*) mutex->bytes);
+#endif
+}
+
+int mutex_storage_lock(mutex_storage_t *mutex)
+{
+#if defined _WIN32 || defined _WIN64
+#ifdef MUTEX_USE_WINDOWS_MUTEX
+	return windows_mutex_lock(*(HANDLE*) mutex->bytes);
+#else
+	return windows_mutex_lock(mutex->bytes);
+#endif
+#else
+	return pthread_mutex_lock((pthread_mutex_t*) mutex->bytes);
+#endif
+}
+
+int mutex_storage_unlock(mutex_storage_t *mutex)
+{
+#if defined _WIN32 || defined _WIN64
+#ifdef MUTEX_USE_WINDOWS_MUTEX
+	return windows_mutex_unlock(*(HANDLE*) mutex->bytes);
+#else
+	return windows_mutex_unlock(mutex->bytes);
+#endif
+#else
+	return pthread_mutex_unlock((pthread_mutex_t*) mutex->bytes);
+#endif
+}
+
+int mutex_storage_trylock(mutex_storage_t *mutex)
+{
+#if defined _WIN32 || defined _WIN64
+	return mutex_storage_timedlock(mutex, 0UL);
+#else
+	return pthread_mutex_trylock((pthread_mutex_t*) mutex->bytes);
+#endif
+}
+
+int mutex_storage_timedlock(mutex_storage_t *mutex, unsigned long milliseconds)
+{
+#if defined _WIN32 || defined _WIN64
+#ifdef MUTEX_USE_WINDOWS_MUTEX
+	return windows_mutex_timedlock(*(HANDLE*) mutex->bytes, milliseconds);
+#else
+	return windows_mutex_timedlock(mutex->bytes, milliseconds);
+#endif
+#else
+	return posix_mutex_timedlock((pthread_mutex_t*) mutex->bytes, milliseconds);
+#endif
+}
+
+int rwlock_init(rwlock_storage_t *rwlock)
+{
+#if defined _WIN32 || defined _WIN64
+	InitializeSRWLock((SRWLOCK*) rwlock->bytes);
+	return 0;
+#else
+	return pthread_rwlock_init((pthread_rwlock_t*) rwlock->bytes, NULL);
+#endif
+}
+
+void rwlock_deinit(rwlock_storage_t *rwlock)
+{
+#if defined _WIN32 || defined _WIN64
+	(void) rwlock; /* an SRWLOCK need not be destroyed */
+#else
+	pthread_rwlock_destroy((pthread_rwlock_t*) rwlock->bytes);
+#endif
+}
+
+int rwlock_lock(rwlock_storage_t *rwlock)
+{
+#if defined _WIN32 || defined _WIN64
+	AcquireSRWLockExclusive((SRWLOCK*) rwlock->bytes);
+	return 0;
+#else
+	return pthread_rwlock_wrlock((pthread_rwlock_t*) rwlock->bytes);
+#endif
+}
+
+int rwlock_unlock(rwlock_storage_t *rwlock)
+{
+#if defined _WIN32 || defined _WIN64
+	ReleaseSRWLockExclusive((SRWLOCK*) rwlock->bytes);
+	return 0;
+#else
+	return pthread_rwlock_unlock((pthread_rwlock_t*) rwlock->bytes);
+#endif
+}
+
+int rwlock_lock_shared(rwlock_storage_t *rwlock)
+{
+#if defined _WIN32 || defined _WIN64
+	AcquireSRWLockShared((SRWLOCK*) rwlock->bytes);
+	return 0;
+#else
+	return pthread_rwlock_rdlock((pthread_rwlock_t*) rwlock->bytes);
+#endif
+}
+
+int rwlock_unlock_shared(rwlock_storage_t *rwlock)
+{
+#if defined _WIN32 || defined _WIN64
+	ReleaseSRWLockShared((SRWLOCK*) rwlock->bytes);
+	return 0;
+#else
+	return pthread_rwlock_unlock((pthread_rwlock_t*) rwlock->bytes);
+#endif
+}
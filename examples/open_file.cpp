@@ -24,13 +24,33 @@ SOFTWARE.
 
 */
 
+// requires C++11
+
+#if !defined _WIN32 && !defined _WIN64
+#define _FILE_OFFSET_BITS 64 // 64-bit offsets for fseeko and mmap on 32-bit systems
+#endif
+
 #include "res_mgr_resource.hpp"
+#include "hex_format.hpp"
 #include <assert.h>
-#include <ctype.h>
 #include <errno.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if !defined _WIN32 && !defined _WIN64
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "res_mgr_io_uring.hpp"
+#define VIEWER_HAS_MMAP
+#define VIEWER_HAS_BLOCK_READER
+#endif
 
 // This program opens a list of files and print their contents as binary data and ASCII characters
 
@@ -73,105 +93,731 @@ struct DynamicMemoryFunctor
 typedef res_mgr::Resource<FILE*, nullptr, FileFunctor> File;
 typedef res_mgr::Resource<void*, nullptr, DynamicMemoryFunctor> DynamicMemory;
 
-size_t get_file_size(FILE* file)
+#ifdef VIEWER_HAS_MMAP
+struct FileDescriptorFunctor
+{
+	static int open_in_read_only_mode(const char* path) {
+		assert(path != nullptr);
+		return open(path, O_RDONLY);
+	}
+
+	void operator()(int fd) {
+		const int status = close(fd);
+		// Comment the following line so that a debug message will not be printed
+		printf(">> Debug message: File descriptor %d closed (status code: %d)\n", fd, status);
+	}
+
+	bool operator()(int fd, int invalid_fd) { return (fd > invalid_fd); }
+};
+
+// The size of the mapping is stored in the functor, so that it is known when the mapping is released.
+struct MappedMemoryFunctor
+{
+	explicit MappedMemoryFunctor(size_t number_of_bytes = 0U) : size(number_of_bytes) {}
+
+	// Maps a part of the file for reading, the offset must be a multiple of the page size. Returns nullptr if it cannot be mapped.
+	static void* map_in_read_only_mode(int fd, unsigned long long offset, size_t number_of_bytes) {
+		void* memory = mmap(nullptr, number_of_bytes, PROT_READ, MAP_PRIVATE, fd, static_cast<off_t>(offset));
+		if (memory == MAP_FAILED)
+			return nullptr;
+		// The file is read once from the beginning to the end.
+		madvise(memory, number_of_bytes, MADV_SEQUENTIAL);
+		return memory;
+	}
+
+	void operator()(void *memory) {
+		const int status = munmap(memory, size);
+		// Comment the following line so that a debug message will not be printed
+		printf(">> Debug message: Mapping at %p unmapped (status code: %d)\n", memory, status);
+	}
+
+	bool operator()(void* memory_address, void* invalid_address) { return (memory_address != invalid_address); }
+
+	size_t size;
+};
+
+typedef res_mgr::Resource<int, -1, FileDescriptorFunctor> FileDescriptor;
+typedef res_mgr::Resource<void*, nullptr, MappedMemoryFunctor> MappedMemory;
+#endif
+
+// Returns false if the file cannot be seeked, e.g. if it is a pipe. The file position is not restored.
+bool seek_file(FILE* file, unsigned long long offset, int origin)
+{
+	assert(file != nullptr);
+#if defined _WIN32 || defined _WIN64
+	return (_fseeki64(file, static_cast<__int64>(offset), origin) == 0);
+#else
+	return (fseeko(file, static_cast<off_t>(offset), origin) == 0);
+#endif
+}
+
+// Gets the size without reading the file, returns false if it cannot be determined.
+bool get_file_size(FILE* file, unsigned long long& file_size)
+{
+	assert(file != nullptr);
+	if (!seek_file(file, 0U, SEEK_END))
+		return false;
+#if defined _WIN32 || defined _WIN64
+	const __int64 end = _ftelli64(file);
+#else
+	const off_t end = ftello(file);
+#endif
+	if (end < 0 || !seek_file(file, 0U, SEEK_SET))
+		return false;
+	file_size = static_cast<unsigned long long>(end);
+	return true;
+}
+
+/*
+Reads the rest of the file into memory, for files that do not report their size, e.g. pipes,
+or that report a size of 0 although they have contents, e.g. the files of procfs.
+Returns false if it runs out of memory, size is the number of bytes read.
+*/
+template<class Memory>
+bool read_to_end(FILE* file, Memory& data, size_t& size)
 {
 	assert(file != nullptr);
-	size_t file_size = 0U;
-	rewind(file);
-	int c = fgetc(file);
-	while (c != EOF) {
-		++file_size;
-		c = fgetc(file);
-	}
-	rewind(file);
-	return file_size;
+	size_t capacity = 4096U;
+	size = 0U;
+	data = DynamicMemoryFunctor::allocate(capacity);
+	if (!data.is_valid())
+		return false;
+
+	for (;;) {
+		size += fread(static_cast<unsigned char*>(data.get()) + size, sizeof(unsigned char), capacity - size, file);
+		if (size < capacity)
+			return true; // the end of the file or an error, see ferror()
+
+		void* grown = realloc(data.get(), capacity * 2U);
+		if (grown == nullptr)
+			return false;
+		data.detach(); // moved by realloc
+		data = grown;
+		capacity *= 2U;
+	}
 }
 
-void print_binary_data(FILE *file, const unsigned char* data, size_t number_of_bytes)
-{
-	const size_t bytes_per_line = 32U;
-	const size_t number_of_lines = number_of_bytes / bytes_per_line;
-	const size_t remaining_bytes = number_of_bytes % bytes_per_line;
-
-	for (size_t i = 0U; i < number_of_lines; ++i) {
-		const size_t offset = i * bytes_per_line;
-		for (size_t j = 0U; j < bytes_per_line; ++j) {
-			const size_t index = offset + j;
-			fprintf(file, "%02X ", data[index]);
-		}
-		fprintf(file, "   ");
-		for (size_t j = 0U; j < bytes_per_line; ++j) {
-			const size_t index = offset + j;
-			unsigned char c = data[index];
-			if (isspace(c)) {
-				c = ' ';
-			} else if (!isprint(c)) {
-				c = '?';
+/*
+Reads a range of a file in chunks into two buffers, so that a chunk can be printed while the next one is read on another thread.
+The memory used does not depend on the size of the file.
+*/
+class ChunkReader
+{
+public:
+	// chunk_size should be a multiple of the number of bytes per line, so that the lines are not split between chunks.
+	ChunkReader(FILE* file, unsigned long long length, size_t chunk_size) :
+		m_file(file), m_remaining(length), m_chunk_size(chunk_size), m_current(0U), m_started(false), m_stop(false), m_error(false)
+	{
+		for (int i = 0; i < 2; ++i) {
+			m_buffers[i] = DynamicMemoryFunctor::allocate(chunk_size);
+			m_filled[i] = 0U;
+			m_ready[i] = false;
+		}
+	}
+
+	~ChunkReader()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_condition.notify_all();
+		if (m_thread.joinable())
+			m_thread.join();
+	}
+
+	bool is_valid() const
+	{
+		return m_buffers[0].is_valid() && m_buffers[1].is_valid();
+	}
+
+	// Returns the number of bytes of the next chunk, 0 at the end of the range.
+	// The data remains valid until the next call.
+	size_t next_chunk(const unsigned char*& data)
+	{
+		assert(is_valid());
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (!m_started) {
+			m_started = true;
+			m_thread = std::thread(&ChunkReader::read_ahead, this);
+		} else {
+			// The previous chunk has been printed, its buffer can be filled again.
+			m_ready[m_current] = false;
+			m_current ^= 1U;
+			m_condition.notify_all();
+		}
+		m_condition.wait(lock, [this]() { return m_ready[m_current]; });
+		data = static_cast<const unsigned char*>(m_buffers[m_current].get());
+		return m_filled[m_current];
+	}
+
+	// Returns true if the file could not be read to the end of the range.
+	bool has_error() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_error;
+	}
+
+private:
+	ChunkReader(const ChunkReader&);
+	ChunkReader& operator=(const ChunkReader&);
+
+	// Runs on the read-ahead thread, an empty chunk marks the end.
+	void read_ahead()
+	{
+		for (size_t i = 0U;; i ^= 1U) {
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_condition.wait(lock, [this, i]() { return m_stop || !m_ready[i]; });
+				if (m_stop)
+					return;
 			}
-			fputc(c, file);
+
+			const size_t size = (m_remaining < m_chunk_size) ? static_cast<size_t>(m_remaining) : m_chunk_size;
+			const size_t read = (size > 0U) ? fread(m_buffers[i].get(), sizeof(unsigned char), size, m_file) : 0U;
+			m_remaining -= read;
+
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_filled[i] = read;
+				m_ready[i] = true;
+				if (read < size)
+					m_error = true;
+			}
+			m_condition.notify_all();
+			if (read == 0U)
+				return;
 		}
-		if ((i + 1) < number_of_lines || remaining_bytes > 0U)
-			fputc('\n', file);
 	}
 
-	if (remaining_bytes > 0U) {
-		const size_t offset = bytes_per_line * number_of_lines;
-		for (size_t i = 0U; i < remaining_bytes; ++i) {
-			const size_t index = offset + i;
-			fprintf(file, "%02X ", data[index]);
+	FILE* m_file;
+	unsigned long long m_remaining; // only used by the read-ahead thread
+	const size_t m_chunk_size;
+	DynamicMemory m_buffers[2];
+	size_t m_current;               // the buffer returned by the last call of next_chunk()
+
+	// The following members are protected by m_mutex.
+	mutable std::mutex m_mutex;
+	std::condition_variable m_condition;
+	size_t m_filled[2];
+	bool m_ready[2];                // true if the buffer has been filled and not printed yet
+	bool m_started;
+	bool m_stop;
+	bool m_error;
+
+	std::thread m_thread;
+};
+
+// The part of a file to print.
+struct ByteRange
+{
+	unsigned long long offset;
+	unsigned long long length; // the rest of the file if it is larger than the remaining size
+
+	// Limits the range to a file of the given size.
+	ByteRange clamp(unsigned long long file_size) const
+	{
+		ByteRange range = { (offset < file_size) ? offset : file_size, 0U };
+		range.length = ((file_size - range.offset) < length) ? (file_size - range.offset) : length;
+		return range;
+	}
+
+	bool is_whole_file() const
+	{
+		return (offset == 0U && length == static_cast<unsigned long long>(-1));
+	}
+};
+
+// Formats the message printed instead of the data of a file, returns the number of characters as snprintf().
+int format_error(char* out, size_t size, const char* path, int error_code, const char* message)
+{
+	return snprintf(out, size, "%s: %s\n", path, ((error_code != 0) ? strerror(error_code) : message));
+}
+
+// Formats the line printed before the data of a file, returns the number of characters as snprintf().
+int format_file_header(char* out, size_t size, const char* path, const ByteRange& requested, const ByteRange& range)
+{
+	const char* plural = (range.length > 1U) ? "s" : "";
+	if (requested.is_whole_file())
+		return snprintf(out, size, "%s: %llu byte%s\n", path, range.length, plural);
+	return snprintf(out, size, "%s: %llu byte%s at offset %llu\n", path, range.length, plural, range.offset);
+}
+
+void print_error(const char* path, const char* message)
+{
+	const int error_code = errno;
+	std::vector<char> text(static_cast<size_t>(format_error(nullptr, 0U, path, error_code, message)) + 1U);
+	format_error(text.data(), text.size(), path, error_code, message);
+	fputs(text.data(), stdout);
+}
+
+void print_file_header(const char* path, const ByteRange& requested, const ByteRange& range)
+{
+	std::vector<char> text(static_cast<size_t>(format_file_header(nullptr, 0U, path, requested, range)) + 1U);
+	format_file_header(text.data(), text.size(), path, requested, range);
+	fputs(text.data(), stdout);
+}
+
+// Reads the whole file into memory and prints the range, for files whose size is not known in advance, see read_to_end.
+void view_file_in_memory(const char* path, const ByteRange& requested, FILE* file)
+{
+	DynamicMemory data;
+	size_t size = 0U;
+	if (!read_to_end(file, data, size)) {
+		print_error(path, "Out of memory.");
+		return;
+	}
+
+	const ByteRange range = requested.clamp(size);
+	print_file_header(path, requested, range);
+	hex_format::print_binary_data(stdout, static_cast<const unsigned char*>(data.get()) + range.offset, static_cast<size_t>(range.length));
+	printf("\n");
+	if (ferror(file))
+		printf("%s: The file could not be read to the end of the range.\n", path);
+}
+
+// Reads the range chunk by chunk and prints each chunk after it has been read.
+void view_file(const char* path, const ByteRange& requested)
+{
+	const size_t max_chunk_size = 1024U * 1024U;
+	errno = 0;
+	const File file = FileFunctor::open_file_in_binary_read_mode(path);
+	if (!file.is_valid()) {
+		print_error(path, "Cannot open file.");
+		return;
+	}
+
+	unsigned long long file_size = 0U;
+	if (!get_file_size(file.get(), file_size) || file_size == 0U) {
+		view_file_in_memory(path, requested, file.get());
+		return;
+	}
+
+	const ByteRange range = requested.clamp(file_size);
+	if (!seek_file(file.get(), range.offset, SEEK_SET)) {
+		print_error(path, "Cannot seek to the offset.");
+		return;
+	}
+
+	// Small ranges get small buffers, a whole line is read at least.
+	const size_t chunk_size = (range.length < max_chunk_size) ?
+		static_cast<size_t>((range.length / hex_format::bytes_per_line + 1U) * hex_format::bytes_per_line) : max_chunk_size;
+	ChunkReader reader(file.get(), range.length, chunk_size);
+	if (!reader.is_valid()) {
+		print_error(path, "Out of memory.");
+		return;
+	}
+
+	print_file_header(path, requested, range);
+	const unsigned char* data = nullptr;
+	bool first_chunk = true;
+	for (size_t size = reader.next_chunk(data); size > 0U; size = reader.next_chunk(data)) {
+		// hex_format::print_binary_data does not end the last line, the lines of two chunks are separated here.
+		if (!first_chunk)
+			fputc('\n', stdout);
+		hex_format::print_binary_data(stdout, data, size);
+		first_chunk = false;
+	}
+	printf("\n");
+	if (reader.has_error())
+		printf("%s: The file could not be read to the end of the range.\n", path);
+}
+
+#ifdef VIEWER_HAS_MMAP
+// Maps the range of the file into memory and prints it from the mapping, the file is neither scanned for its size nor copied.
+void view_mapped_file(const char* path, const ByteRange& requested)
+{
+	errno = 0;
+	MappedMemory mapping;
+	ByteRange range = { 0U, 0U };
+	size_t page_offset = 0U; // the mapping starts at a page boundary, the range may start inside the page
+	{
+		FileDescriptor fd = FileDescriptorFunctor::open_in_read_only_mode(path);
+		if (!fd.is_valid()) {
+			print_error(path, "Cannot open file.");
+			return;
+		}
+
+		struct stat file_status;
+		if (fstat(fd.get(), &file_status) != 0) {
+			print_error(path, "Cannot get the file size.");
+			return;
+		}
+		// The size of a file that is not regular, e.g. a pipe, or of a file in /proc is not known in advance,
+		// so the file cannot be mapped and is read to the end instead.
+		if (!S_ISREG(file_status.st_mode) || file_status.st_size == 0) {
+			fd.release();
+			view_file(path, requested);
+			return;
 		}
-		for (size_t i = remaining_bytes; i < bytes_per_line; ++i) {
-			fprintf(file, "   ");
+
+		range = requested.clamp(static_cast<unsigned long long>(file_status.st_size));
+		const unsigned long long page_size = static_cast<unsigned long long>(sysconf(_SC_PAGESIZE));
+		page_offset = static_cast<size_t>(range.offset % page_size);
+		if (range.length + page_offset > static_cast<size_t>(-1)) {
+			printf("%s: The range is too large to be mapped.\n", path);
+			return;
 		}
-		fprintf(file, "   ");
-		for (size_t i = 0U; i < remaining_bytes; ++i) {
-			const size_t index = offset + i;
-			unsigned char c = data[index];
-			if (isspace(c)) {
-				c = ' ';
+
+		const size_t mapping_size = static_cast<size_t>(range.length) + page_offset;
+		if (range.length > 0U) {
+			// The mapping remains valid after the file descriptor has been closed.
+			MappedMemory new_mapping(MappedMemoryFunctor::map_in_read_only_mode(fd.get(), range.offset - page_offset, mapping_size),
+				MappedMemoryFunctor(mapping_size));
+			mapping.swap(new_mapping);
+			if (!mapping.is_valid() && errno == ENODEV) {
+				// The file system does not support mapping, e.g. sysfs.
+				fd.release();
+				view_file(path, requested);
+				return;
 			}
-			else if (!isprint(c)) {
-				c = '?';
+			if (!mapping.is_valid()) {
+				print_error(path, "Cannot map file.");
+				return;
 			}
-			fputc(c, file);
 		}
 	}
+	print_file_header(path, requested, range);
+	hex_format::print_binary_data(stdout, static_cast<const unsigned char*>(mapping.get()) + (mapping.is_valid() ? page_offset : 0U),
+		static_cast<size_t>(range.length));
+	printf("\n");
 }
+#endif
 
-int main(int argc, char *argv[])
+/*
+Reads and formats several files at the same time on a pool of threads and prints them in the order of the arguments.
+The text of each file, the same text that view_file prints, is formatted into its own buffer,
+which is released after it has been printed. The workers stay at most a few files ahead of the file being printed,
+so that the memory used is bounded. Ranges larger than max_buffered_length are printed by view_file when their turn comes.
+*/
+class ParallelViewer
 {
-	if (argc < 2) {
-		printf("Usage: %s <file>\n", argv[0]);
-		return 0;
+public:
+	ParallelViewer(char* const* paths, size_t number_of_files, const ByteRange& requested, unsigned int thread_count) :
+		m_paths(paths), m_requested(requested), m_thread_count((thread_count > 0U) ? thread_count : 1U),
+		m_outputs(number_of_files), m_next(0U), m_printed(0U)
+	{
 	}
 
-	for (int i = 1; i < argc; ++i) {
-		errno = 0;
-		size_t file_size = 0U;
-		DynamicMemory dyn_mem;
+	void run()
+	{
+		std::vector<std::thread> threads;
+		for (unsigned int i = 0U; i < m_thread_count; ++i)
+			threads.push_back(std::thread(&ParallelViewer::work, this));
+
+		for (size_t i = 0U; i < m_outputs.size(); ++i) {
+			FormattedFile& output = m_outputs[i];
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_condition.wait(lock, [&output]() { return output.state != FormattedFile::pending; });
+			}
+			if (output.state == FormattedFile::formatted) {
+				fwrite(output.text.get(), sizeof(char), output.size, stdout);
+				output.text.release();
+			} else {
+				view_file(m_paths[i], m_requested);
+			}
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_printed = i + 1U;
+			}
+			m_condition.notify_all();
+		}
+
+		for (size_t i = 0U; i < threads.size(); ++i)
+			threads[i].join();
+	}
+
+private:
+	static const unsigned long long max_buffered_length = 16U * 1024U * 1024U;
+
+	struct FormattedFile
+	{
+		enum State { pending, formatted, too_large };
+
+		FormattedFile() : size(0U), state(pending)
 		{
-			const File file = FileFunctor::open_file_in_binary_read_mode(argv[i]);
-			if (!file.is_valid()) {
-				const int error_code = errno;
-				printf("%s: %s\n", argv[i], ((error_code != 0) ? strerror(error_code) : "Cannot open file."));
+		}
+
+		DynamicMemory text;
+		size_t size;
+		State state; // protected by m_mutex
+	};
+
+	// The temporaries of a worker are released without a debug message,
+	// which the worker would print out of order with the files being printed.
+	struct QuietFileFunctor
+	{
+		void operator()(FILE *fp) { fclose(fp); }
+		bool operator()(FILE* fp, FILE* invalid_file) { return (fp != invalid_file); }
+	};
+
+	struct QuietMemoryFunctor
+	{
+		void operator()(void *memory) { free(memory); }
+		bool operator()(void* memory_address, void* invalid_address) { return (memory_address != invalid_address); }
+	};
+
+	typedef res_mgr::Resource<FILE*, nullptr, QuietFileFunctor> QuietFile;
+	typedef res_mgr::Resource<void*, nullptr, QuietMemoryFunctor> QuietMemory;
+
+	ParallelViewer(const ParallelViewer&);
+	ParallelViewer& operator=(const ParallelViewer&);
+
+	void work()
+	{
+		const size_t window = 4U * m_thread_count;
+		for (;;) {
+			size_t index = 0U;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_condition.wait(lock, [this, window]() { return m_next >= m_outputs.size() || m_next < m_printed + window; });
+				if (m_next >= m_outputs.size())
+					return;
+				index = m_next++;
+			}
+
+			FormattedFile& output = m_outputs[index];
+			const bool formatted = format_file(m_paths[index], output);
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				output.state = formatted ? FormattedFile::formatted : FormattedFile::too_large;
+			}
+			m_condition.notify_all();
+		}
+	}
+
+	// Formats the text that view_file would print, returns false if the range is too large to be buffered.
+	bool format_file(const char* path, FormattedFile& output)
+	{
+		errno = 0;
+		const QuietFile file = FileFunctor::open_file_in_binary_read_mode(path);
+		if (!file.is_valid())
+			return store_error(path, "Cannot open file.", output);
+
+		QuietMemory data;
+		ByteRange range = { 0U, 0U };
+		size_t length = 0U;
+		size_t read = 0U;
+		size_t data_offset = 0U; // the range starts at this offset of data
+		unsigned long long file_size = 0U;
+		if (get_file_size(file.get(), file_size) && file_size > 0U) {
+			range = m_requested.clamp(file_size);
+			if (range.length > max_buffered_length)
+				return false;
+			if (!seek_file(file.get(), range.offset, SEEK_SET))
+				return store_error(path, "Cannot seek to the offset.", output);
+
+			length = static_cast<size_t>(range.length);
+			data = DynamicMemoryFunctor::allocate(length + 1U);
+			if (!data.is_valid())
+				return store_error(path, "Out of memory.", output);
+			read = fread(data.get(), sizeof(unsigned char), length, file.get());
+		} else {
+			// The size is not known in advance, see read_to_end.
+			size_t size = 0U;
+			if (!read_to_end(file.get(), data, size))
+				return store_error(path, "Out of memory.", output);
+			range = m_requested.clamp(size);
+			data_offset = static_cast<size_t>(range.offset);
+			length = static_cast<size_t>(range.length);
+			read = length;
+		}
+		const bool incomplete = (read < length) || ferror(file.get());
+
+		// output.text is released on the main thread after it has been printed, so it is allocated only once, with the message included.
+		const char* const incomplete_message = "%s: The file could not be read to the end of the range.\n";
+		const size_t header_size = static_cast<size_t>(format_file_header(nullptr, 0U, path, m_requested, range));
+		const size_t message_size = incomplete ? static_cast<size_t>(snprintf(nullptr, 0U, incomplete_message, path)) : 0U;
+		const size_t text_size = header_size + hex_format::get_formatted_size(read) + 1U + message_size;
+		output.text = DynamicMemoryFunctor::allocate(text_size + 1U); // snprintf writes a terminating null character
+		if (!output.text.is_valid())
+			return store_error(path, "Out of memory.", output);
+
+		char* text = static_cast<char*>(output.text.get());
+		format_file_header(text, text_size + 1U, path, m_requested, range);
+		size_t size = header_size + hex_format::format_binary_data(static_cast<const unsigned char*>(data.get()) + data_offset, read, text + header_size);
+		text[size++] = '\n';
+		if (incomplete)
+			size += static_cast<size_t>(snprintf(text + size, message_size + 1U, incomplete_message, path));
+		output.size = size;
+		return true;
+	}
+
+	// Stores the error message as the text of the file, always returns true.
+	static bool store_error(const char* path, const char* message, FormattedFile& output)
+	{
+		const int error_code = errno;
+		const size_t size = static_cast<size_t>(format_error(nullptr, 0U, path, error_code, message));
+		output.text = DynamicMemoryFunctor::allocate(size + 1U);
+		output.size = 0U;
+		if (output.text.is_valid()) {
+			format_error(static_cast<char*>(output.text.get()), size + 1U, path, error_code, message);
+			output.size = size;
+		}
+		return true;
+	}
+
+	char* const* m_paths;
+	const ByteRange m_requested;
+	const unsigned int m_thread_count;
+	std::vector<FormattedFile> m_outputs;
+
+	// The following members are protected by m_mutex.
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	size_t m_next;    // the next file to be formatted
+	size_t m_printed; // the number of files printed
+};
+
+#ifdef VIEWER_HAS_BLOCK_READER
+/*
+Prints the files with a BlockReader, which opens and closes a batch of files with one io_uring submission each
+and keeps several reads of a file in flight, or uses open() and pread() if io_uring is not available.
+*/
+void view_files_with_block_reader(char* const* paths, size_t number_of_files, const ByteRange& requested)
+{
+	const size_t batch_size = 32U;
+	res_mgr::BlockReader reader;
+	if (!reader.is_valid()) {
+		printf("Cannot allocate the read buffers.\n");
+		return;
+	}
+
+	for (size_t first = 0U; first < number_of_files; first += batch_size) {
+		const size_t count = (number_of_files - first < batch_size) ? (number_of_files - first) : batch_size;
+		reader.open(paths + first, count);
+		for (size_t i = 0U; i < count; ++i) {
+			const char* path = paths[first + i];
+			errno = reader.get_error(i);
+			if (errno != 0) {
+				print_error(path, "Cannot open file.");
 				continue;
 			}
 
-			file_size = get_file_size(file.get());
-			dyn_mem = DynamicMemoryFunctor::allocate(file_size);
-			if (!dyn_mem.is_valid()) {
-				const int error_code = errno;
-				printf("%s: %s\n", argv[i], ((error_code != 0) ? strerror(error_code): "Out of memory."));
+			struct stat file_status;
+			if (fstat(reader.get_fd(i), &file_status) != 0) {
+				print_error(path, "Cannot get the file size.");
+				continue;
+			}
+			// The size of a file that is not regular, e.g. in /proc, is not known in advance, see read_to_end.
+			if (!S_ISREG(file_status.st_mode) || file_status.st_size == 0) {
+				view_file(path, requested);
 				continue;
 			}
 
-			fread(dyn_mem.get(), sizeof(unsigned char), file_size, file.get());
+			const ByteRange range = requested.clamp(static_cast<unsigned long long>(file_status.st_size));
+			print_file_header(path, requested, range);
+			bool first_block = true;
+			unsigned long long printed = 0U;
+			const int error = reader.read(i, range.offset, range.length, [&first_block, &printed](const unsigned char* data, size_t size) {
+				// The blocks are multiples of the line size, the lines of two blocks are separated here.
+				if (!first_block)
+					fputc('\n', stdout);
+				hex_format::print_binary_data(stdout, data, size);
+				first_block = false;
+				printed += size;
+			});
+			printf("\n");
+			if (error != 0 || printed < range.length)
+				printf("%s: The file could not be read to the end of the range.\n", path);
+		}
+		reader.close();
+	}
+}
+#endif
+
+void print_usage(const char* program)
+{
+#ifdef VIEWER_HAS_MMAP
+	printf("Usage: %s [-m | -j <threads> | -u] [-o <offset>] [-n <length>] <file>...\n", program);
+	printf("  -m: map the files into memory instead of reading them\n");
+	printf("  -u: read the files with io_uring, or with pread if io_uring is not available\n");
+#else
+	printf("Usage: %s [-j <threads>] [-o <offset>] [-n <length>] <file>...\n", program);
+#endif
+	printf("  -o: print from the given offset, 0 by default\n");
+	printf("  -n: print at most the given number of bytes, the rest of the file by default\n");
+	printf("  -j: read and format the files on the given number of threads, the files are still printed in order\n");
+	printf("  Offsets and lengths may be given in decimal or in hexadecimal with a 0x prefix.\n");
+}
+
+bool parse_number(const char* text, unsigned long long& number)
+{
+	if (text == nullptr || *text == '\0' || *text == '-')
+		return false;
+	char* end = nullptr;
+	errno = 0;
+	number = strtoull(text, &end, 0);
+	return (errno == 0 && *end == '\0');
+}
+
+int main(int argc, char *argv[])
+{
+	bool use_mmap = false;
+	bool use_block_reader = false;
+	unsigned long long thread_count = 0U;
+	ByteRange range = { 0U, static_cast<unsigned long long>(-1) };
+	int first_file = 1;
+	for (; first_file < argc && argv[first_file][0] == '-'; ++first_file) {
+		const char* option = argv[first_file];
+		if (strcmp(option, "-m") == 0) {
+			use_mmap = true;
+#ifdef VIEWER_HAS_BLOCK_READER
+		} else if (strcmp(option, "-u") == 0) {
+			use_block_reader = true;
+#endif
+		} else if (strcmp(option, "-o") == 0 && first_file + 1 < argc && parse_number(argv[first_file + 1], range.offset)) {
+			++first_file;
+		} else if (strcmp(option, "-j") == 0 && first_file + 1 < argc && parse_number(argv[first_file + 1], thread_count)) {
+			++first_file;
+		} else if (strcmp(option, "-n") == 0 && first_file + 1 < argc && parse_number(argv[first_file + 1], range.length)) {
+			++first_file;
+		} else {
+			printf("Invalid option: %s\n", option);
+			print_usage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (argc <= first_file) {
+		print_usage(argv[0]);
+		return 0;
+	}
+
+#ifndef VIEWER_HAS_MMAP
+	if (use_mmap)
+		printf(">> Memory mapping is not supported on this platform, the files are read instead.\n");
+#endif
+
+	if ((use_mmap ? 1 : 0) + (use_block_reader ? 1 : 0) + ((thread_count > 0U) ? 1 : 0) > 1) {
+		printf("Only one of the options -m, -j and -u can be used.\n");
+		return 1;
+	}
+
+#ifdef VIEWER_HAS_BLOCK_READER
+	if (use_block_reader) {
+		view_files_with_block_reader(argv + first_file, static_cast<size_t>(argc - first_file), range);
+		return 0;
+	}
+#endif
+
+	if (thread_count > 0U) {
+		const unsigned int max_thread_count = 256U;
+		ParallelViewer viewer(argv + first_file, static_cast<size_t>(argc - first_file), range,
+			static_cast<unsigned int>((thread_count < max_thread_count) ? thread_count : max_thread_count));
+		viewer.run();
+		return 0;
+	}
+
+	for (int i = first_file; i < argc; ++i) {
+#ifdef VIEWER_HAS_MMAP
+		if (use_mmap) {
+			view_mapped_file(argv[i], range);
+			continue;
 		}
-		printf("%s: %lu byte%s\n", argv[i], static_cast<unsigned long>(file_size), ((file_size > 1U) ? "s" : ""));
-		print_binary_data(stdout, static_cast<const unsigned char*>(dyn_mem.get()), file_size);
-		printf("\n");
-		DynamicMemory dyn_mem2;
-		dyn_mem2.swap(dyn_mem);
+#endif
+		view_file(argv[i], range);
 	}
 
 	return 0;
@@ -0,0 +1,124 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026 MH Lim
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// requires C++11
+
+// This program compares releasing shared descriptors on the thread that drops the last reference
+// with queuing them on a res_mgr::DeferredReclaimer, which releases them in batches on its own thread.
+// Only the time spent by the thread that drops the references is measured, so deferring pays off when the reclaimer has a core of its own.
+
+#include "res_mgr_reclaim.hpp"
+#include "res_mgr_shared.hpp"
+#include "benchmark.hpp"
+
+#include <atomic>
+#include <stdio.h>
+#include <stdlib.h>
+
+static std::atomic<size_t> g_released_descriptors(0U);
+
+// Descriptors are simulated, releasing one takes some work like a close() that flushes buffered data.
+struct DescriptorFunctor
+{
+	void operator()(int fd) {
+		unsigned int hash = static_cast<unsigned int>(fd);
+		for (int i = 0; i < 200; ++i)
+			hash = hash * 2654435761U + 1U;
+		benchmark::do_not_optimize(hash);
+		g_released_descriptors.fetch_add(1U, std::memory_order_relaxed);
+	}
+
+	bool operator()(int fd, int invalid_fd) { return (fd > invalid_fd); }
+};
+
+typedef res_mgr::DeferredReclaimer<int, DescriptorFunctor> DescriptorReclaimer;
+typedef res_mgr::DeferredFunctor<int, DescriptorFunctor> DeferredDescriptorFunctor;
+typedef res_mgr::SharedResource<int, -1, DescriptorFunctor, long, std::atomic<long> > SharedDescriptor;
+typedef res_mgr::SharedResource<int, -1, DeferredDescriptorFunctor, long, std::atomic<long> > DeferredSharedDescriptor;
+
+static void use_descriptors(size_t count)
+{
+	for (size_t i = 0U; i < count; ++i) {
+		SharedDescriptor descriptor(static_cast<int>(i % 1024U));
+		SharedDescriptor copy = descriptor;
+		benchmark::do_not_optimize(copy.get());
+	}
+}
+
+static void use_deferred_descriptors(size_t count, DescriptorReclaimer& reclaimer)
+{
+	for (size_t i = 0U; i < count; ++i) {
+		DeferredSharedDescriptor descriptor(static_cast<int>(i % 1024U), DeferredDescriptorFunctor(&reclaimer));
+		DeferredSharedDescriptor copy = descriptor;
+		benchmark::do_not_optimize(copy.get());
+	}
+}
+
+static bool check_released(const char* name, size_t expected)
+{
+	const size_t released = g_released_descriptors.exchange(0U, std::memory_order_relaxed);
+	if (released != expected) {
+		printf("Error: %s released %lu descriptors instead of %lu\n", name, static_cast<unsigned long>(released), static_cast<unsigned long>(expected));
+		return false;
+	}
+	return true;
+}
+
+int main(int argc, char *argv[])
+{
+	size_t count = 0U;
+	if (!benchmark::parse_count_argument(argc, argv, "iterations", 100000U, count))
+		return 1;
+	const int repetitions = 5;
+
+	printf("Dropping %lu shared descriptors, best of %d runs\n", static_cast<unsigned long>(count), repetitions);
+
+	const double inline_ns = benchmark::best_of(repetitions, [count]() {
+		use_descriptors(count);
+	});
+	benchmark::report("released by the last reference", inline_ns, count);
+	if (!check_released("SharedDescriptor", count * repetitions))
+		return 1;
+
+	DescriptorReclaimer reclaimer(256U, std::chrono::milliseconds(5));
+	const double deferred_ns = benchmark::best_of(repetitions, [count, &reclaimer]() {
+		use_deferred_descriptors(count, reclaimer);
+	});
+	benchmark::report("queued on a DeferredReclaimer", deferred_ns, count);
+
+	// Releases what the reclaimer thread has not released yet on this thread.
+	reclaimer.flush();
+	const size_t drained = reclaimer.drain();
+	const res_mgr::ReclaimerStats stats = reclaimer.get_stats();
+	printf("%lu descriptors released by the reclaimer in %lu batches, %lu drained at the end, average latency %.0f ns, max latency %.0f ns\n",
+		static_cast<unsigned long>(stats.reclaimed), static_cast<unsigned long>(stats.batches), static_cast<unsigned long>(drained),
+		stats.average_latency_ns, stats.max_latency_ns);
+	if (stats.queued != count * repetitions || stats.reclaimed != stats.queued || stats.queue_depth != 0U || stats.average_latency_ns < 0.0) {
+		printf("Error: the reclaimer queued %lu descriptors and released %lu\n", static_cast<unsigned long>(stats.queued), static_cast<unsigned long>(stats.reclaimed));
+		return 1;
+	}
+	if (!check_released("DeferredReclaimer", count * repetitions))
+		return 1;
+	return 0;
+}
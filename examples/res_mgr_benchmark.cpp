@@ -0,0 +1,389 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026 MH Lim
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// requires C++11
+
+// This program measures the primitives of res_mgr and prints the results as a table, CSV or JSON, see --help.
+// The other benchmark programs in this folder compare alternatives in more detail, this one tracks the cost of each primitive.
+
+#include "res_mgr_atomic.hpp"
+#include "res_mgr_lock.hpp"
+#include "res_mgr_resource.hpp"
+#include "res_mgr_shared.hpp"
+#include "res_mgr_spinlock.hpp"
+#include "mutex.h"
+#include "benchmark.hpp"
+#include "hex_format.hpp"
+
+#include <atomic>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+// Descriptors are simulated so that the benchmark does not depend on the system calls that would release real ones.
+static std::atomic<size_t> g_released_descriptors(0U);
+
+struct DescriptorFunctor
+{
+	void operator()(int) {
+		g_released_descriptors.fetch_add(1U, std::memory_order_relaxed);
+	}
+
+	bool operator()(int fd, int invalid_fd) { return (fd > invalid_fd); }
+};
+
+typedef res_mgr::Resource<int, -1, DescriptorFunctor> Descriptor;
+typedef res_mgr::SharedResource<int, -1, DescriptorFunctor, long, std::atomic<long> > SharedDescriptor;
+
+// The locks of mutex.h, the baseline of the other locks.
+struct MutexInitFunctor {
+	void operator()(mutex_storage_t &mutex) {
+		mutex_init(&mutex);
+	}
+};
+
+struct MutexDeinitFunctor {
+	void operator()(mutex_storage_t &mutex) {
+		mutex_deinit(&mutex);
+	}
+};
+
+struct MutexLockFunctor {
+	void operator()(mutex_storage_t &mutex) {
+		mutex_storage_lock(&mutex);
+	}
+};
+
+struct MutexUnlockFunctor {
+	void operator()(mutex_storage_t &mutex) {
+		mutex_storage_unlock(&mutex);
+	}
+};
+
+struct RWLockInitFunctor {
+	void operator()(rwlock_storage_t &rwlock) {
+		rwlock_init(&rwlock);
+	}
+};
+
+struct RWLockDeinitFunctor {
+	void operator()(rwlock_storage_t &rwlock) {
+		rwlock_deinit(&rwlock);
+	}
+};
+
+struct RWLockLockFunctor {
+	void operator()(rwlock_storage_t &rwlock) {
+		rwlock_lock(&rwlock);
+	}
+};
+
+struct RWLockUnlockFunctor {
+	void operator()(rwlock_storage_t &rwlock) {
+		rwlock_unlock(&rwlock);
+	}
+};
+
+struct RWLockLockSharedFunctor {
+	void operator()(rwlock_storage_t &rwlock) {
+		rwlock_lock_shared(&rwlock);
+	}
+};
+
+struct RWLockUnlockSharedFunctor {
+	void operator()(rwlock_storage_t &rwlock) {
+		rwlock_unlock_shared(&rwlock);
+	}
+};
+
+typedef res_mgr::ResourceLock<mutex_storage_t, MutexInitFunctor, MutexDeinitFunctor, MutexLockFunctor, MutexUnlockFunctor> Mutex;
+typedef res_mgr::ResourceSharedLock<rwlock_storage_t, RWLockInitFunctor, RWLockDeinitFunctor, RWLockLockFunctor, RWLockUnlockFunctor,
+	RWLockLockSharedFunctor, RWLockUnlockSharedFunctor> RWLock;
+
+// The numbers of threads of the multithreaded benchmarks, the same as in shared_resource_benchmark.
+static const int thread_counts[] = { 1, 4, 16, 64 };
+static const size_t max_thread_count = 64U;
+
+struct Options
+{
+	benchmark::Reporter::Format format;
+	const char* output;
+	int samples;
+	size_t operations;
+};
+
+static void benchmark_resource(benchmark::Reporter& reporter, const Options& options)
+{
+	const size_t count = options.operations;
+	reporter.add("resource", "construct and release", benchmark::sample(options.samples, count, [count]() {
+		for (size_t i = 0U; i < count; ++i) {
+			Descriptor descriptor(static_cast<int>(i));
+			benchmark::do_not_optimize(descriptor);
+		}
+	}));
+
+	reporter.add("resource", "move", benchmark::sample(options.samples, count, [count]() {
+		Descriptor descriptors[2] = { Descriptor(1), Descriptor() };
+		for (size_t i = 0U; i < count; ++i) {
+			descriptors[(i + 1U) & 1U] = std::move(descriptors[i & 1U]);
+			benchmark::do_not_optimize(descriptors[0]);
+		}
+	}));
+}
+
+// Every thread copies and destroys the same shared resource, the operations are split evenly among the threads.
+static void copy_and_destroy_concurrently(const SharedDescriptor& shared, size_t count, int thread_count)
+{
+	const size_t count_per_thread = count / static_cast<size_t>(thread_count);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < thread_count; ++t) {
+		threads.push_back(std::thread([&shared, count_per_thread]() {
+			for (size_t i = 0U; i < count_per_thread; ++i) {
+				SharedDescriptor copy(shared);
+				benchmark::do_not_optimize(copy);
+			}
+		}));
+	}
+	for (size_t i = 0U; i < threads.size(); ++i)
+		threads[i].join();
+}
+
+static void benchmark_shared_resource(benchmark::Reporter& reporter, const Options& options)
+{
+	const size_t count = options.operations;
+	const SharedDescriptor shared(3);
+	for (int thread_count : thread_counts) {
+		char name[64];
+		snprintf(name, sizeof(name), "copy and destroy %d thread(s)", thread_count);
+		const size_t operations = (count / static_cast<size_t>(thread_count)) * static_cast<size_t>(thread_count);
+		reporter.add("shared_resource", name, benchmark::sample(options.samples, operations, [&shared, count, thread_count]() {
+			copy_and_destroy_concurrently(shared, count, thread_count);
+		}));
+	}
+}
+
+template<class Function>
+static void benchmark_atomic_operation(benchmark::Reporter& reporter, const Options& options, const char* name, Function operation)
+{
+	const size_t count = options.operations;
+	std::atomic<long> value(0L);
+	reporter.add("atomic", name, benchmark::sample(options.samples, count, [&value, count, operation]() {
+		for (size_t i = 0U; i < count; ++i)
+			benchmark::do_not_optimize(operation(&value, static_cast<long>(i)));
+	}));
+}
+
+static void benchmark_atomic(benchmark::Reporter& reporter, const Options& options)
+{
+	typedef std::atomic<long> AtomicType;
+	benchmark_atomic_operation(reporter, options, "atomic_increment", [](AtomicType* p, long) { return res_mgr::atomic_increment<long, AtomicType>(p); });
+	benchmark_atomic_operation(reporter, options, "atomic_decrement", [](AtomicType* p, long) { return res_mgr::atomic_decrement<long, AtomicType>(p); });
+	benchmark_atomic_operation(reporter, options, "atomic_load", [](AtomicType* p, long) { return res_mgr::atomic_load<long, AtomicType>(p); });
+	benchmark_atomic_operation(reporter, options, "atomic_store", [](AtomicType* p, long v) {
+		res_mgr::atomic_store<long, AtomicType>(p, v);
+		return v;
+	});
+	benchmark_atomic_operation(reporter, options, "atomic_exchange", [](AtomicType* p, long v) { return res_mgr::atomic_exchange<long, AtomicType>(p, v); });
+	benchmark_atomic_operation(reporter, options, "atomic_compare_exchange_weak", [](AtomicType* p, long v) {
+		long expected = v - 1L;
+		return res_mgr::atomic_compare_exchange_weak<long, AtomicType>(p, expected, v);
+	});
+	benchmark_atomic_operation(reporter, options, "atomic_compare_exchange_strong", [](AtomicType* p, long v) {
+		long expected = v - 1L;
+		return res_mgr::atomic_compare_exchange_strong<long, AtomicType>(p, expected, v);
+	});
+	benchmark_atomic_operation(reporter, options, "atomic_add", [](AtomicType* p, long) { return res_mgr::atomic_add<long, AtomicType>(p, 3L); });
+	benchmark_atomic_operation(reporter, options, "atomic_sub", [](AtomicType* p, long) { return res_mgr::atomic_sub<long, AtomicType>(p, 3L); });
+	benchmark_atomic_operation(reporter, options, "atomic_and", [](AtomicType* p, long v) { return res_mgr::atomic_and<long, AtomicType>(p, v); });
+	benchmark_atomic_operation(reporter, options, "atomic_or", [](AtomicType* p, long v) { return res_mgr::atomic_or<long, AtomicType>(p, v); });
+	benchmark_atomic_operation(reporter, options, "atomic_xor", [](AtomicType* p, long v) { return res_mgr::atomic_xor<long, AtomicType>(p, v); });
+	benchmark_atomic_operation(reporter, options, "atomic_fetch_add", [](AtomicType* p, long) { return res_mgr::atomic_fetch_add<long, AtomicType>(p, 3L); });
+	benchmark_atomic_operation(reporter, options, "atomic_fetch_sub", [](AtomicType* p, long) { return res_mgr::atomic_fetch_sub<long, AtomicType>(p, 3L); });
+	benchmark_atomic_operation(reporter, options, "atomic_fetch_and", [](AtomicType* p, long v) { return res_mgr::atomic_fetch_and<long, AtomicType>(p, v); });
+	benchmark_atomic_operation(reporter, options, "atomic_fetch_or", [](AtomicType* p, long v) { return res_mgr::atomic_fetch_or<long, AtomicType>(p, v); });
+	benchmark_atomic_operation(reporter, options, "atomic_fetch_xor", [](AtomicType* p, long v) { return res_mgr::atomic_fetch_xor<long, AtomicType>(p, v); });
+}
+
+// All threads lock the same lock and increment one counter, the operations are split evenly among the threads.
+// GuardType holds the lock, ResourceLockMechanism for writing or SharedLockMechanism for reading.
+template<class LockType, class GuardType>
+static void lock_and_increment_concurrently(LockType& lock, size_t& counter, size_t count, int thread_count)
+{
+	const size_t count_per_thread = count / static_cast<size_t>(thread_count);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < thread_count; ++t) {
+		threads.push_back(std::thread([&lock, &counter, count_per_thread]() {
+			for (size_t i = 0U; i < count_per_thread; ++i) {
+				GuardType guard(lock);
+				benchmark::do_not_optimize(++counter);
+			}
+		}));
+	}
+	for (size_t i = 0U; i < threads.size(); ++i)
+		threads[i].join();
+}
+
+// The counter is only read when the lock is held for reading, as the readers may hold it at the same time.
+template<class LockType>
+static void lock_and_read_concurrently(LockType& lock, size_t& counter, size_t count, int thread_count)
+{
+	const size_t count_per_thread = count / static_cast<size_t>(thread_count);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < thread_count; ++t) {
+		threads.push_back(std::thread([&lock, &counter, count_per_thread]() {
+			for (size_t i = 0U; i < count_per_thread; ++i) {
+				res_mgr::SharedLockMechanism<LockType> guard(lock);
+				benchmark::do_not_optimize(counter);
+			}
+		}));
+	}
+	for (size_t i = 0U; i < threads.size(); ++i)
+		threads[i].join();
+}
+
+// Uncontended, the lock is acquired by the thread of the benchmark, then contended by every number of threads in thread_counts.
+template<class LockType>
+static void benchmark_lock_type(benchmark::Reporter& reporter, const Options& options, const char* lock_name)
+{
+	const size_t count = options.operations;
+	LockType lock;
+	size_t counter = 0U;
+	char name[64];
+	snprintf(name, sizeof(name), "%s uncontended", lock_name);
+	reporter.add("lock", name, benchmark::sample(options.samples, count, [&lock, &counter, count]() {
+		for (size_t i = 0U; i < count; ++i) {
+			res_mgr::ResourceLockMechanism<LockType> guard(lock);
+			benchmark::do_not_optimize(++counter);
+		}
+	}));
+
+	for (int thread_count : thread_counts) {
+		const size_t operations = (count / static_cast<size_t>(thread_count)) * static_cast<size_t>(thread_count);
+		snprintf(name, sizeof(name), "%s contended %d thread(s)", lock_name, thread_count);
+		reporter.add("lock", name, benchmark::sample(options.samples, operations, [&lock, &counter, count, thread_count]() {
+			lock_and_increment_concurrently<LockType, res_mgr::ResourceLockMechanism<LockType> >(lock, counter, count, thread_count);
+		}));
+	}
+}
+
+// The same cases as benchmark_lock_type with the lock held for reading.
+template<class LockType>
+static void benchmark_shared_lock_type(benchmark::Reporter& reporter, const Options& options, const char* lock_name)
+{
+	const size_t count = options.operations;
+	LockType lock;
+	size_t counter = 0U;
+	char name[64];
+	snprintf(name, sizeof(name), "%s shared uncontended", lock_name);
+	reporter.add("lock", name, benchmark::sample(options.samples, count, [&lock, &counter, count]() {
+		for (size_t i = 0U; i < count; ++i) {
+			res_mgr::SharedLockMechanism<LockType> guard(lock);
+			benchmark::do_not_optimize(counter);
+		}
+	}));
+
+	for (int thread_count : thread_counts) {
+		const size_t operations = (count / static_cast<size_t>(thread_count)) * static_cast<size_t>(thread_count);
+		snprintf(name, sizeof(name), "%s shared contended %d thread(s)", lock_name, thread_count);
+		reporter.add("lock", name, benchmark::sample(options.samples, operations, [&lock, &counter, count, thread_count]() {
+			lock_and_read_concurrently(lock, counter, count, thread_count);
+		}));
+	}
+}
+
+static void benchmark_lock(benchmark::Reporter& reporter, const Options& options)
+{
+	benchmark_lock_type<Mutex>(reporter, options, "ResourceLock mutex");
+	benchmark_lock_type<RWLock>(reporter, options, "ResourceSharedLock rwlock");
+	benchmark_shared_lock_type<RWLock>(reporter, options, "ResourceSharedLock rwlock");
+	benchmark_lock_type<res_mgr::SpinLock>(reporter, options, "TTAS spinlock");
+	benchmark_lock_type<res_mgr::TicketLock>(reporter, options, "ticket lock");
+	benchmark_lock_type<res_mgr::AdaptiveLock>(reporter, options, "adaptive lock");
+}
+
+// The formatter of binary_file_viewer, the operations are bytes.
+static void benchmark_hex_format(benchmark::Reporter& reporter, const Options& options)
+{
+	const size_t size = 1024U * 1024U;
+	std::vector<unsigned char> data(size);
+	for (size_t i = 0U; i < size; ++i)
+		data[i] = static_cast<unsigned char>((i * 2654435761U) >> 13);
+	std::vector<char> text(hex_format::get_formatted_size(size));
+	reporter.add("hex_format", "format_binary_data 1 MiB", benchmark::sample(options.samples, size, [&data, &text]() {
+		benchmark::do_not_optimize(hex_format::format_binary_data(data.data(), data.size(), text.data()));
+	}));
+}
+
+static void print_usage(const char* program)
+{
+	printf("Usage: %s [--format text|csv|json] [--output <file>] [--samples <count>] [--operations <count>]\n", program);
+	printf("  --format: the output format, text by default\n");
+	printf("  --output: the file the results are written to, the standard output by default\n");
+	printf("  --samples: the number of timed runs of each benchmark, 20 by default\n");
+	printf("  --operations: the number of operations per run, at least 64, 1000000 by default\n");
+}
+
+int main(int argc, char *argv[])
+{
+	Options options = { benchmark::Reporter::text, NULL, 20, 1000000U };
+	for (int i = 1; i < argc; ++i) {
+		const bool has_value = (i + 1 < argc);
+		size_t value = 0U;
+		if (strcmp(argv[i], "--format") == 0 && has_value && benchmark::Reporter::parse_format(argv[i + 1], options.format)) {
+			++i;
+		} else if (strcmp(argv[i], "--output") == 0 && has_value) {
+			options.output = argv[++i];
+		} else if (strcmp(argv[i], "--samples") == 0 && has_value && benchmark::parse_count(argv[i + 1], value) && value <= 1000000U) {
+			options.samples = static_cast<int>(value);
+			++i;
+		} else if (strcmp(argv[i], "--operations") == 0 && has_value && benchmark::parse_count(argv[i + 1], value) && value >= max_thread_count) {
+			options.operations = value;
+			++i;
+		} else {
+			print_usage(argv[0]);
+			return (strcmp(argv[i], "--help") == 0) ? 0 : 1;
+		}
+	}
+
+	FILE* file = (options.output != NULL) ? fopen(options.output, "w") : stdout;
+	if (file == NULL) {
+		printf("Error: cannot open %s\n", options.output);
+		return 1;
+	}
+
+	{
+		benchmark::Reporter reporter(options.format, file);
+		benchmark_resource(reporter, options);
+		benchmark_shared_resource(reporter, options);
+		benchmark_atomic(reporter, options);
+		benchmark_lock(reporter, options);
+		benchmark_hex_format(reporter, options);
+	}
+
+	if (file != stdout)
+		fclose(file);
+	return 0;
+}
@@ -0,0 +1,95 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026 MH Lim
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// requires C++11
+
+// This program compares the growth of a std::vector of resource objects that are moved when the vector reallocates
+// with a std::vector of heap allocated resource objects (one extra allocation per element).
+
+#include "res_mgr_resource.hpp"
+#include "benchmark.hpp"
+
+#include <memory>
+#include <stdio.h>
+#include <stdlib.h>
+#include <type_traits>
+#include <vector>
+
+// Descriptors are simulated so that the benchmark does not run into the limit of open files of the process.
+static size_t g_released_descriptors = 0U;
+
+struct DescriptorFunctor
+{
+	void operator()(int) {
+		++g_released_descriptors;
+	}
+
+	bool operator()(int fd, int invalid_fd) { return (fd > invalid_fd); }
+};
+
+typedef res_mgr::Resource<int, -1, DescriptorFunctor> Descriptor;
+
+static_assert(sizeof(Descriptor) == sizeof(int), "A resource object should be as large as the raw resource.");
+static_assert(std::is_nothrow_move_constructible<Descriptor>::value, "std::vector should move resource objects when it grows.");
+static_assert(!std::is_copy_constructible<Descriptor>::value, "Resource objects should not be copyable.");
+
+static void grow_vector_of_resources(size_t count)
+{
+	std::vector<Descriptor> descriptors;
+	for (size_t i = 0U; i < count; ++i)
+		descriptors.push_back(Descriptor(static_cast<int>(i)));
+	benchmark::do_not_optimize(descriptors.data());
+}
+
+static void grow_vector_of_heap_resources(size_t count)
+{
+	std::vector<std::unique_ptr<Descriptor>> descriptors;
+	for (size_t i = 0U; i < count; ++i)
+		descriptors.push_back(std::unique_ptr<Descriptor>(new Descriptor(static_cast<int>(i))));
+	benchmark::do_not_optimize(descriptors.data());
+}
+
+int main(int argc, char *argv[])
+{
+	size_t count = 0U;
+	if (!benchmark::parse_count_argument(argc, argv, "iterations", 100000U, count))
+		return 1;
+	const int repetitions = 10;
+
+	printf("Growing a std::vector to %lu descriptors, best of %d runs\n", static_cast<unsigned long>(count), repetitions);
+
+	double ns = benchmark::best_of(repetitions, [count]() { grow_vector_of_resources(count); });
+	benchmark::report("std::vector<Descriptor> (move)", ns, count);
+
+	ns = benchmark::best_of(repetitions, [count]() { grow_vector_of_heap_resources(count); });
+	benchmark::report("std::vector<std::unique_ptr<Descriptor>> (heap)", ns, count);
+
+	const size_t expected = 2U * count * static_cast<size_t>(repetitions);
+	if (g_released_descriptors != expected) {
+		printf("Error: %lu descriptors released, %lu expected\n",
+			static_cast<unsigned long>(g_released_descriptors), static_cast<unsigned long>(expected));
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,331 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026 MH Lim
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// requires C++11
+
+// This program measures the cost of creating, copying and destroying shared resources.
+
+#include "res_mgr_counter.hpp"
+#include "res_mgr_epoch.hpp"
+#include "res_mgr_intrusive.hpp"
+#include "res_mgr_pool.hpp"
+#include "res_mgr_shared.hpp"
+#include "benchmark.hpp"
+
+#include <atomic>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+
+struct DynamicMemoryFunctor
+{
+	static void* allocate(size_t number_of_bytes) {
+		return calloc(number_of_bytes, sizeof(unsigned char));
+	}
+
+	void operator()(void* memory) {
+		free(memory);
+	}
+
+	bool operator()(void* memory_address, void* invalid_address) { return (memory_address != invalid_address); }
+};
+
+// Descriptors are simulated, only the cost of the reference counting is measured.
+struct DescriptorFunctor
+{
+	void operator()(int) {
+	}
+
+	bool operator()(int fd, int invalid_fd) { return (fd > invalid_fd); }
+};
+
+typedef res_mgr::SharedResource<void*, nullptr, DynamicMemoryFunctor, long, std::atomic<long>> SharedDynamicMemory;
+typedef res_mgr::SharedMemory<long, std::atomic<long>>::type SharedMemory;
+typedef res_mgr::SharedResource<int, -1, DescriptorFunctor, long, std::atomic<long>> SharedDescriptor;
+typedef res_mgr::SharedResource<int, -1, DescriptorFunctor, long, std::atomic<long>, res_mgr::HeapRefCountAllocator<std::atomic<long>>,
+	res_mgr::SequentiallyConsistentRefCountPolicy<long, std::atomic<long>>> SequentiallyConsistentSharedDescriptor;
+typedef res_mgr::SharedResource<int, -1, DescriptorFunctor, long, res_mgr::NonAtomicCounter<long>> SingleThreadSharedDescriptor;
+typedef res_mgr::SlabRefCountAllocator<std::atomic<long>> SlabAllocator;
+typedef res_mgr::SharedResource<int, -1, DescriptorFunctor, long, std::atomic<long>, SlabAllocator> PooledSharedDescriptor;
+
+struct Message : public res_mgr::IntrusiveRefCounter<long, std::atomic<long>>
+{
+	char text[56];
+};
+
+struct MessageFunctor
+{
+	void operator()(Message* message) {
+		delete message;
+	}
+
+	bool operator()(Message* message, Message* invalid_message) { return (message != invalid_message); }
+};
+
+typedef res_mgr::SharedResource<Message*, nullptr, MessageFunctor, long, std::atomic<long>> SharedMessage;
+typedef res_mgr::IntrusiveSharedResource<Message*, nullptr, MessageFunctor> IntrusiveSharedMessage;
+
+typedef res_mgr::EpochResource<Message*, nullptr, MessageFunctor> EpochMessage;
+
+static_assert(sizeof(IntrusiveSharedMessage) == sizeof(Message*), "An intrusive shared resource should be as large as a pointer.");
+
+// Creates a short-lived buffer, shares it once, writes to it and releases it.
+template<class SharedBuffer, class Factory>
+static void create_share_and_release(size_t count, size_t number_of_bytes, Factory factory)
+{
+	for (size_t i = 0U; i < count; ++i) {
+		SharedBuffer buffer = factory(number_of_bytes);
+		SharedBuffer copy = buffer;
+		static_cast<unsigned char*>(copy.get())[0] = static_cast<unsigned char>(i);
+		benchmark::do_not_optimize(copy.get());
+	}
+}
+
+static void benchmark_allocation(size_t count, int repetitions)
+{
+	const size_t sizes[] = { 16U, 64U, 256U, 4096U };
+	for (size_t size : sizes) {
+		char name[64];
+		double ns = benchmark::best_of(repetitions, [count, size]() {
+			create_share_and_release<SharedDynamicMemory>(count, size, [](size_t n) {
+				return SharedDynamicMemory(DynamicMemoryFunctor::allocate(n));
+			});
+		});
+		snprintf(name, sizeof(name), "two allocations, %lu bytes", static_cast<unsigned long>(size));
+		benchmark::report(name, ns, count);
+
+		ns = benchmark::best_of(repetitions, [count, size]() {
+			create_share_and_release<SharedMemory>(count, size, [](size_t n) {
+				return res_mgr::make_shared_resource<long, std::atomic<long>>(n);
+			});
+		});
+		snprintf(name, sizeof(name), "make_shared_resource, %lu bytes", static_cast<unsigned long>(size));
+		benchmark::report(name, ns, count);
+	}
+}
+
+// Every thread keeps a window of live descriptors and replaces the oldest one in each iteration.
+template<class SharedDescriptorType>
+static void create_and_release_descriptors(size_t count, int thread_count)
+{
+	const size_t window = 256U;
+	std::vector<std::thread> threads;
+	for (int t = 0; t < thread_count; ++t) {
+		threads.push_back(std::thread([count, window]() {
+			std::vector<SharedDescriptorType> descriptors(window);
+			for (size_t i = 0U; i < count; ++i)
+				descriptors[i % window] = static_cast<int>(i);
+		}));
+	}
+	for (size_t i = 0U; i < threads.size(); ++i)
+		threads[i].join();
+}
+
+static void benchmark_refcount_allocator(size_t count, int repetitions)
+{
+	const int thread_counts[] = { 1, 4 };
+	for (int thread_count : thread_counts) {
+		char name[64];
+		const size_t operations = count * static_cast<size_t>(thread_count);
+		double ns = benchmark::best_of(repetitions, [count, thread_count]() {
+			create_and_release_descriptors<SharedDescriptor>(count, thread_count);
+		});
+		snprintf(name, sizeof(name), "operator new counters, %d thread(s)", thread_count);
+		benchmark::report(name, ns, operations);
+
+		ns = benchmark::best_of(repetitions, [count, thread_count]() {
+			create_and_release_descriptors<PooledSharedDescriptor>(count, thread_count);
+		});
+		snprintf(name, sizeof(name), "slab pool counters, %d thread(s)", thread_count);
+		benchmark::report(name, ns, operations);
+	}
+
+	const res_mgr::SlabPoolStats stats = SlabAllocator::get_stats();
+	printf("Slab pool: %lu live blocks, %lu slab(s) of %lu blocks of %lu bytes, occupancy %.2f%%\n",
+		static_cast<unsigned long>(stats.live_blocks), static_cast<unsigned long>(stats.slab_count),
+		static_cast<unsigned long>(stats.blocks_per_slab), static_cast<unsigned long>(stats.block_size), stats.occupancy * 100.0);
+}
+
+// All threads copy and destroy the same shared descriptor, the operations are split evenly among the threads.
+template<class SharedDescriptorType>
+static void copy_and_destroy_concurrently(size_t count, int thread_count)
+{
+	const SharedDescriptorType descriptor = 3;
+	const size_t count_per_thread = count / static_cast<size_t>(thread_count);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < thread_count; ++t) {
+		threads.push_back(std::thread([&descriptor, count_per_thread]() {
+			for (size_t i = 0U; i < count_per_thread; ++i) {
+				SharedDescriptorType copy = descriptor;
+				benchmark::do_not_optimize(copy);
+			}
+		}));
+	}
+	for (size_t i = 0U; i < threads.size(); ++i)
+		threads[i].join();
+}
+
+static void benchmark_refcount_policy(size_t count, int repetitions)
+{
+	const int thread_counts[] = { 1, 4, 16, 64 };
+	for (int thread_count : thread_counts) {
+		char name[64];
+		const size_t operations = (count / static_cast<size_t>(thread_count)) * static_cast<size_t>(thread_count);
+		double ns = benchmark::best_of(repetitions, [count, thread_count]() {
+			copy_and_destroy_concurrently<SequentiallyConsistentSharedDescriptor>(count, thread_count);
+		});
+		snprintf(name, sizeof(name), "seq_cst policy, %d thread(s)", thread_count);
+		benchmark::report(name, ns, operations);
+
+		ns = benchmark::best_of(repetitions, [count, thread_count]() {
+			copy_and_destroy_concurrently<SharedDescriptor>(count, thread_count);
+		});
+		snprintf(name, sizeof(name), "relaxed/release policy, %d thread(s)", thread_count);
+		benchmark::report(name, ns, operations);
+	}
+}
+
+// Copies a shared descriptor into a window of instances on a single thread.
+template<class SharedDescriptorType>
+static void copy_and_destroy_locally(size_t count)
+{
+	const size_t window = 64U;
+	SharedDescriptorType descriptor = 3;
+	std::vector<SharedDescriptorType> copies(window);
+	for (size_t i = 0U; i < count; ++i)
+		copies[i % window] = descriptor;
+	benchmark::do_not_optimize(copies[0]);
+}
+
+static void benchmark_non_atomic_counter(size_t count, int repetitions)
+{
+	double ns = benchmark::best_of(repetitions, [count]() { copy_and_destroy_locally<SharedDescriptor>(count); });
+	benchmark::report("std::atomic<long> counter", ns, count);
+
+	ns = benchmark::best_of(repetitions, [count]() { copy_and_destroy_locally<SingleThreadSharedDescriptor>(count); });
+	benchmark::report("NonAtomicCounter<long> counter", ns, count);
+}
+
+// Copies a shared message into a window of instances and reads it through each copy.
+template<class SharedMessageType>
+static void copy_and_destroy(size_t count)
+{
+	const size_t window = 64U;
+	SharedMessageType message = new Message;
+	std::vector<SharedMessageType> copies(window);
+	for (size_t i = 0U; i < count; ++i) {
+		copies[i % window] = message;
+		benchmark::do_not_optimize(copies[i % window].get()->text[0]);
+	}
+}
+
+static void benchmark_intrusive(size_t count, int repetitions)
+{
+	double ns = benchmark::best_of(repetitions, [count]() { copy_and_destroy<SharedMessage>(count); });
+	benchmark::report("SharedResource copy", ns, count);
+
+	ns = benchmark::best_of(repetitions, [count]() { copy_and_destroy<IntrusiveSharedMessage>(count); });
+	benchmark::report("IntrusiveSharedResource copy", ns, count);
+}
+
+// All threads read the current message, the operations are split evenly among the threads.
+static void read_shared_concurrently(size_t count, int thread_count)
+{
+	const SharedMessage current = new Message;
+	const size_t count_per_thread = count / static_cast<size_t>(thread_count);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < thread_count; ++t) {
+		threads.push_back(std::thread([&current, count_per_thread]() {
+			for (size_t i = 0U; i < count_per_thread; ++i) {
+				SharedMessage snapshot = current;
+				benchmark::do_not_optimize(snapshot.get()->text[0]);
+			}
+		}));
+	}
+	for (size_t i = 0U; i < threads.size(); ++i)
+		threads[i].join();
+}
+
+static void read_epoch_concurrently(size_t count, int thread_count)
+{
+	EpochMessage current(new Message);
+	const size_t count_per_thread = count / static_cast<size_t>(thread_count);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < thread_count; ++t) {
+		threads.push_back(std::thread([&current, count_per_thread]() {
+			for (size_t i = 0U; i < count_per_thread; ++i) {
+				res_mgr::EpochGuard guard;
+				benchmark::do_not_optimize(current.load()->text[0]);
+			}
+		}));
+	}
+	current.store(new Message); // the old message is released once the readers have left
+	for (size_t i = 0U; i < threads.size(); ++i)
+		threads[i].join();
+}
+
+static void benchmark_epoch(size_t count, int repetitions)
+{
+	const int thread_counts[] = { 1, 4, 16 };
+	for (int thread_count : thread_counts) {
+		char name[64];
+		const size_t operations = (count / static_cast<size_t>(thread_count)) * static_cast<size_t>(thread_count);
+		double ns = benchmark::best_of(repetitions, [count, thread_count]() { read_shared_concurrently(count, thread_count); });
+		snprintf(name, sizeof(name), "SharedResource snapshot, %d thread(s)", thread_count);
+		benchmark::report(name, ns, operations);
+
+		ns = benchmark::best_of(repetitions, [count, thread_count]() { read_epoch_concurrently(count, thread_count); });
+		snprintf(name, sizeof(name), "EpochResource read, %d thread(s)", thread_count);
+		benchmark::report(name, ns, operations);
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	size_t count = 0U;
+	if (!benchmark::parse_count_argument(argc, argv, "iterations", 1000000U, count))
+		return 1;
+	const int repetitions = 5;
+
+	printf("Creating, copying and releasing %lu shared buffers, best of %d runs\n", static_cast<unsigned long>(count), repetitions);
+	benchmark_allocation(count, repetitions);
+
+	printf("Creating and releasing %lu shared descriptors per thread, best of %d runs\n", static_cast<unsigned long>(count), repetitions);
+	benchmark_refcount_allocator(count, repetitions);
+
+	printf("Copying and destroying one shared descriptor %lu times from several threads, best of %d runs\n",
+		static_cast<unsigned long>(count), repetitions);
+	benchmark_refcount_policy(count, repetitions);
+
+	printf("Copying a shared descriptor %lu times on one thread, best of %d runs\n", static_cast<unsigned long>(count), repetitions);
+	benchmark_non_atomic_counter(count, repetitions);
+
+	printf("Copying a shared object %lu times, best of %d runs\n", static_cast<unsigned long>(count), repetitions);
+	benchmark_intrusive(count, repetitions);
+
+	printf("Reading a shared object %lu times from several threads, best of %d runs\n", static_cast<unsigned long>(count), repetitions);
+	benchmark_epoch(count, repetitions);
+	return 0;
+}
@@ -25,10 +25,13 @@ SOFTWARE.
 // requires C++11
 
 #include "res_mgr_atomic.hpp"
+#include "res_mgr_atomic_shared.hpp"
 #include "res_mgr_lock.hpp"
 #include "res_mgr_shared.hpp"
+#include "res_mgr_weak.hpp"
 #include "mutex.h"
 
+#include <assert.h>
 #include <atomic>
 #include <stdio.h>
 #include <stdlib.h>
@@ -48,27 +51,64 @@ constexpr size_t sizeof_array(T (&array)[size])
 	return size;
 }
 
+// The locks are stored in ResourceLock and ResourceSharedLock themselves, so they are not allocated and locking them does not follow a pointer.
 struct MutexInitFunctor {
-	void operator()(void* &mutex) {
-		mutex = mutex_create();
+	void operator()(mutex_storage_t &mutex) {
+		mutex_init(&mutex);
 	}
 };
 
 struct MutexDeinitFunctor {
-	void operator()(void *mutex) {
-		mutex_destroy(mutex);
+	void operator()(mutex_storage_t &mutex) {
+		mutex_deinit(&mutex);
 	}
 };
 
 struct MutexLockFunctor {
-	void operator()(void *mutex) {
-		mutex_lock(mutex);
+	void operator()(mutex_storage_t &mutex) {
+		mutex_storage_lock(&mutex);
 	}
 };
 
 struct MutexUnlockFunctor {
-	void operator()(void *mutex) {
-		mutex_unlock(mutex);
+	void operator()(mutex_storage_t &mutex) {
+		mutex_storage_unlock(&mutex);
+	}
+};
+
+struct RWLockInitFunctor {
+	void operator()(rwlock_storage_t &rwlock) {
+		rwlock_init(&rwlock);
+	}
+};
+
+struct RWLockDeinitFunctor {
+	void operator()(rwlock_storage_t &rwlock) {
+		rwlock_deinit(&rwlock);
+	}
+};
+
+struct RWLockLockFunctor {
+	void operator()(rwlock_storage_t &rwlock) {
+		rwlock_lock(&rwlock);
+	}
+};
+
+struct RWLockUnlockFunctor {
+	void operator()(rwlock_storage_t &rwlock) {
+		rwlock_unlock(&rwlock);
+	}
+};
+
+struct RWLockLockSharedFunctor {
+	void operator()(rwlock_storage_t &rwlock) {
+		rwlock_lock_shared(&rwlock);
+	}
+};
+
+struct RWLockUnlockSharedFunctor {
+	void operator()(rwlock_storage_t &rwlock) {
+		rwlock_unlock_shared(&rwlock);
 	}
 };
 
@@ -88,13 +128,19 @@ struct DynamicMemoryFunctor
 };
 
 typedef res_mgr::SharedResource<void*, nullptr, DynamicMemoryFunctor, long, std::atomic<long>> SharedDynamicMemory;
-typedef res_mgr::ResourceLock<void*, MutexInitFunctor, MutexDeinitFunctor, MutexLockFunctor, MutexUnlockFunctor> Mutex;
+typedef res_mgr::AtomicSharedResource<SharedDynamicMemory> AtomicSharedDynamicMemory;
+typedef res_mgr::ResourceLock<mutex_storage_t, MutexInitFunctor, MutexDeinitFunctor, MutexLockFunctor, MutexUnlockFunctor> Mutex;
 typedef res_mgr::ResourceLockMechanism<Mutex> MutexLock;
+typedef res_mgr::ResourceSharedLock<rwlock_storage_t, RWLockInitFunctor, RWLockDeinitFunctor, RWLockLockFunctor, RWLockUnlockFunctor,
+	RWLockLockSharedFunctor, RWLockUnlockSharedFunctor> RWLock;
+typedef res_mgr::ResourceLockMechanism<RWLock> WriteLock;
+typedef res_mgr::SharedLockMechanism<RWLock> ReadLock;
 typedef std::atomic<unsigned int> atomic_uint_type;
 
 struct thread_data_type {
-	Mutex mutex;
-	SharedDynamicMemory shared_memory;
+	Mutex mutex;   // guards thread_count and text
+	RWLock lock;   // guards exit, which is read by every thread in every iteration
+	AtomicSharedDynamicMemory shared_memory; // read without the lock
 	atomic_uint_type count;
 	int thread_count;
 	unsigned int n;
@@ -111,6 +157,56 @@ struct thread_data_type {
 	}
 };
 
+// Descriptors are simulated, the functor counts the released ones so that the test can check when a resource is released.
+static int g_released_descriptors = 0;
+
+struct DescriptorFunctor
+{
+	void operator()(int) {
+		++g_released_descriptors;
+	}
+
+	bool operator()(int fd, int invalid_fd) { return (fd > invalid_fd); }
+};
+
+typedef res_mgr::SharedResource<int, -1, DescriptorFunctor, long, std::atomic<long>, res_mgr::WeakRefCountAllocator<long, std::atomic<long> > > SharedDescriptor;
+typedef res_mgr::WeakResource<SharedDescriptor> WeakDescriptor;
+
+static void test_weak_resource()
+{
+	const WeakDescriptor empty;
+	assert(empty.expired());
+	assert(!empty.lock().is_valid());
+
+	WeakDescriptor weak;
+	{
+		SharedDescriptor shared = 3;
+		weak = shared;
+		assert(!weak.expired());
+		assert(weak.get_refcount() == 1);
+		{
+			// lock() adds a strong reference while the resource is alive.
+			const SharedDescriptor locked = weak.lock();
+			assert(locked.is_valid() && locked.get() == 3);
+			assert(shared.get_refcount() == 2);
+		}
+		assert(shared.get_refcount() == 1);
+		assert(g_released_descriptors == 0);
+	}
+
+	// The resource is released with the last strong reference, the weak references keep only the control block alive.
+	assert(g_released_descriptors == 1);
+	assert(weak.expired());
+	assert(!weak.lock().is_valid());
+
+	WeakDescriptor copy(weak);
+	weak.reset();
+	assert(copy.expired());
+	assert(copy.get_refcount() == 0);
+	// The control block is deleted together with copy, the last weak reference.
+	printf("WeakResource tests passed\n");
+}
+
 #if defined _WIN32 || defined _WIN64
 unsigned int __stdcall thread_procedure(void *param)
 #else
@@ -128,17 +224,17 @@ void *thread_procedure(void *param)
 	SharedDynamicMemory shared_mem;
 	thread_data_type* data = static_cast<thread_data_type*>(param);
 
+	shared_mem = data->shared_memory.load();
 	{
 		MutexLock lock(data->mutex);
 		thread_id = ++(data->thread_count);
-		shared_mem = data->shared_memory;
 		printf("reference count = %ld\n", shared_mem.get_refcount());
 	}
 
 	for (;;) {
 		int exit = 0;
 		{
-			MutexLock lock(data->mutex);
+			ReadLock lock(data->lock);
 			exit = data->exit;
 		}
 
@@ -185,17 +281,20 @@ int main(void)
 	constexpr size_t number_of_bytes = 11;
 	thread_handle_type threads[MAX_THREAD_COUNT] = {};
 	thread_data_type data;
-	printf("reference count = %ld\n", data.shared_memory.get_refcount());
-	data.shared_memory = DynamicMemoryFunctor::allocate(number_of_bytes);
-	if (data.shared_memory.is_valid()) {
+	test_weak_resource();
+	printf("reference count = %ld\n", data.shared_memory.load().get_refcount());
+	SharedDynamicMemory shared_memory = DynamicMemoryFunctor::allocate(number_of_bytes);
+	if (shared_memory.is_valid()) {
 		const unsigned char digits[] = { '9','8','7','6','5','4','3','2','1','0', '\0'};
-		unsigned char* mem = static_cast<unsigned char*>(data.shared_memory.get());
+		unsigned char* mem = static_cast<unsigned char*>(shared_memory.get());
 		static_assert(sizeof_array(digits) <= number_of_bytes, "Size mismatch.");
 		for (int i = 0; i < number_of_bytes; ++i) {
 			mem[i] = digits[i];
 		}
 	}
-	printf("reference count = %ld\n", data.shared_memory.get_refcount());
+	data.shared_memory.store(shared_memory);
+	shared_memory.release();
+	printf("reference count = %ld\n", data.shared_memory.load().get_refcount());
 
 #if defined _WIN32 || defined _WIN64
 	for (int i = 0; i < MAX_THREAD_COUNT; i++)
@@ -210,7 +309,7 @@ int main(void)
 #endif
 
 	{
-		MutexLock lock(data.mutex);
+		WriteLock lock(data.lock);
 		data.exit = true;
 	}
 
@@ -220,6 +319,6 @@ int main(void)
 	for (int i = 0; i < MAX_THREAD_COUNT; i++)
 		pthread_join(threads[i], NULL);
 #endif
-	printf("reference count = %ld\n", data.shared_memory.get_refcount());
+	printf("reference count = %ld\n", data.shared_memory.load().get_refcount());
 	return 0;
 }
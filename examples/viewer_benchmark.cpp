@@ -0,0 +1,216 @@
+/*
+The MIT License (MIT)
+
+Copyright (c) 2026 MH Lim
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+// requires C++11
+
+// This program measures binary_file_viewer printing many files sequentially and with its worker pool (-j).
+// It writes the files to the current directory, runs the viewer with the output discarded and removes the files.
+// Before that, it checks that every mode of the viewer prints the same text as the sequential mode.
+
+#include "benchmark.hpp"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined _WIN32 || defined _WIN64
+static const char* const null_device = "NUL";
+#else
+static const char* const null_device = "/dev/null";
+#endif
+
+static bool create_files(size_t number_of_files, size_t file_size, std::vector<std::string>& paths)
+{
+	std::vector<unsigned char> data(file_size);
+	unsigned int seed = 12345U;
+	for (size_t i = 0U; i < data.size(); ++i) {
+		seed = seed * 1103515245U + 12345U;
+		data[i] = static_cast<unsigned char>(seed >> 16);
+	}
+
+	for (size_t i = 0U; i < number_of_files; ++i) {
+		char path[64];
+		snprintf(path, sizeof(path), "viewer_benchmark_%lu.bin", static_cast<unsigned long>(i));
+		FILE* file = fopen(path, "wb");
+		if (file == NULL)
+			return false;
+		paths.push_back(path);
+		const bool written = (fwrite(data.data(), 1U, data.size(), file) == data.size());
+		if (fclose(file) != 0 || !written)
+			return false;
+	}
+	return true;
+}
+
+static void remove_files(std::vector<std::string>& paths)
+{
+	for (size_t i = 0U; i < paths.size(); ++i)
+		remove(paths[i].c_str());
+	paths.clear();
+}
+
+// Runs the viewer and reads its output without the lines starting with ">>", e.g. the debug messages, whose addresses differ between runs.
+static bool run_viewer(const std::string& command, std::string& output)
+{
+	const char* const output_path = "viewer_benchmark_output.txt";
+	output.clear();
+	const bool succeeded = (system((command + " > " + output_path).c_str()) == 0);
+	FILE* file = fopen(output_path, "rb");
+	if (file != NULL) {
+		char line[4096];
+		while (fgets(line, sizeof(line), file) != NULL) {
+			if (strncmp(line, ">>", 2U) != 0)
+				output += line;
+		}
+		fclose(file);
+	}
+	remove(output_path);
+	return succeeded && file != NULL;
+}
+
+// Returns false if a mode prints something else than the sequential mode for a regular file, an empty file
+// and, where it exists, a file whose size is not known in advance.
+static bool check_viewer(const char* viewer)
+{
+	std::vector<std::string> paths;
+	bool created = create_files(2U, 5000U, paths);
+	FILE* empty_file = fopen("viewer_benchmark_empty.bin", "wb");
+	if (empty_file != NULL) {
+		paths.push_back("viewer_benchmark_empty.bin");
+		created = (fclose(empty_file) == 0) && created;
+	} else {
+		created = false;
+	}
+	if (!created) {
+		printf("Error: cannot create the files\n");
+		remove_files(paths);
+		return false;
+	}
+
+	std::string file_list;
+	for (size_t i = 0U; i < paths.size(); ++i)
+		file_list += " " + paths[i];
+#if !defined _WIN32 && !defined _WIN64
+	// Files in /proc report a size of 0, they are read to the end.
+	FILE* proc_file = fopen("/proc/version", "rb");
+	if (proc_file != NULL) {
+		fclose(proc_file);
+		file_list += " /proc/version";
+	}
+	const char* const modes[] = { "-j 4", "-m", "-u" };
+#else
+	const char* const modes[] = { "-j 4", "-m" };
+#endif
+	const char* const ranges[] = { "", " -o 5 -n 100", " -o 4990" };
+
+	bool matched = true;
+	for (const char* range : ranges) {
+		const std::string sequential_command = std::string(viewer) + range + file_list;
+		std::string expected;
+		if (!run_viewer(sequential_command, expected)) {
+			printf("Error: %s failed\n", viewer);
+			matched = false;
+			break;
+		}
+		for (const char* mode : modes) {
+			const std::string command = std::string(viewer) + " " + mode + range + file_list;
+			std::string output;
+			if (!run_viewer(command, output) || output != expected) {
+				printf("Error: \"%s\" prints something else than \"%s\"\n", command.c_str(), sequential_command.c_str());
+				matched = false;
+			}
+		}
+	}
+	remove_files(paths);
+	return matched;
+}
+
+static void benchmark_viewer(const char* viewer, size_t number_of_files, size_t file_size, int repetitions)
+{
+	std::vector<std::string> paths;
+	if (!create_files(number_of_files, file_size, paths)) {
+		printf("Error: cannot create the files\n");
+		remove_files(paths);
+		return;
+	}
+
+	std::string file_list;
+	for (size_t i = 0U; i < paths.size(); ++i)
+		file_list += " " + paths[i];
+
+	const unsigned int hardware_threads = std::thread::hardware_concurrency();
+	const unsigned int thread_counts[] = { 0U, 4U, (hardware_threads > 0U) ? hardware_threads : 1U };
+	for (unsigned int thread_count : thread_counts) {
+		std::string command = viewer;
+		if (thread_count > 0U)
+			command += " -j " + std::to_string(thread_count);
+		command += file_list + " > " + null_device;
+
+		bool failed = false;
+		const double ns = benchmark::best_of(repetitions, [&command, &failed]() {
+			if (system(command.c_str()) != 0)
+				failed = true;
+		});
+		if (failed) {
+			printf("Error: %s failed\n", viewer);
+			break;
+		}
+
+		char name[64];
+		if (thread_count > 0U)
+			snprintf(name, sizeof(name), "%lu x %lu bytes, %u thread(s)", static_cast<unsigned long>(number_of_files),
+				static_cast<unsigned long>(file_size), thread_count);
+		else
+			snprintf(name, sizeof(name), "%lu x %lu bytes, sequential", static_cast<unsigned long>(number_of_files),
+				static_cast<unsigned long>(file_size));
+		benchmark::report(name, ns, number_of_files);
+	}
+	remove_files(paths);
+}
+
+int main(int argc, char *argv[])
+{
+#if defined _WIN32 || defined _WIN64
+	const char* viewer = (argc > 1) ? argv[1] : "binary_file_viewer.exe";
+#else
+	const char* viewer = (argc > 1) ? argv[1] : "./binary_file_viewer";
+#endif
+	const int repetitions = 3;
+	struct { size_t number_of_files; size_t file_size; } const cases[] = {
+		{ 16U, 1024U }, { 256U, 1024U }, { 2048U, 1024U },
+		{ 16U, 64U * 1024U }, { 256U, 64U * 1024U },
+		{ 16U, 4U * 1024U * 1024U }
+	};
+
+	if (!check_viewer(viewer))
+		return 1;
+
+	printf("Printing files with %s, best of %d runs, ns per file\n", viewer, repetitions);
+	for (size_t i = 0U; i < sizeof(cases) / sizeof(cases[0]); ++i)
+		benchmark_viewer(viewer, cases[i].number_of_files, cases[i].file_size, repetitions);
+	return 0;
+}
@@ -29,14 +29,66 @@ SOFTWARE.
 #define MY_MUTEX_EXPORT
 #endif
 
+/* large enough for pthread_mutex_t, CRITICAL_SECTION and a mutex HANDLE */
+#ifndef MUTEX_STORAGE_SIZE
+#define MUTEX_STORAGE_SIZE 64
+#endif
+
+/* large enough for pthread_rwlock_t and SRWLOCK */
+#ifndef RWLOCK_STORAGE_SIZE
+#ifdef __APPLE__
+#define RWLOCK_STORAGE_SIZE 208
+#else
+#define RWLOCK_STORAGE_SIZE 64
+#endif
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/*
+Opaque storage for a mutex, which is placed in the object that uses it instead of being allocated on the heap.
+It can be embedded next to the data it protects, e.g. in the same cache line.
+A mutex must not be copied or moved after it is initialized.
+*/
+typedef union mutex_storage_t {
+	unsigned char bytes[MUTEX_STORAGE_SIZE];
+	void *align_pointer;
+	long long align_integer;
+	double align_floating_point;
+} mutex_storage_t;
+
+/* Opaque storage for a reader-writer lock, used like mutex_storage_t. */
+typedef union rwlock_storage_t {
+	unsigned char bytes[RWLOCK_STORAGE_SIZE];
+	void *align_pointer;
+	long long align_integer;
+	double align_floating_point;
+} rwlock_storage_t;
+
 MY_MUTEX_EXPORT void *mutex_create(); /* returns NULL on failure */
 MY_MUTEX_EXPORT void mutex_destroy(void *mutex);
 MY_MUTEX_EXPORT int mutex_lock(void *mutex); /* returns 0 on success, non-zero otherwise */
 MY_MUTEX_EXPORT int mutex_unlock(void *mutex); /* returns 0 on success, non-zero otherwise */
+MY_MUTEX_EXPORT int mutex_trylock(void *mutex); /* returns 0 if the mutex was acquired without waiting, non-zero otherwise */
+/* The timeout of the timed functions is measured on CLOCK_MONOTONIC with glibc 2.30 or later, on other POSIX systems it is
+   measured on CLOCK_REALTIME and changes if the system time is changed while waiting. */
+MY_MUTEX_EXPORT int mutex_timedlock(void *mutex, unsigned long milliseconds); /* returns 0 if the mutex was acquired in time, non-zero otherwise */
+
+MY_MUTEX_EXPORT int mutex_init(mutex_storage_t *mutex); /* returns 0 on success, non-zero otherwise */
+MY_MUTEX_EXPORT void mutex_deinit(mutex_storage_t *mutex);
+MY_MUTEX_EXPORT int mutex_storage_lock(mutex_storage_t *mutex); /* returns 0 on success, non-zero otherwise */
+MY_MUTEX_EXPORT int mutex_storage_unlock(mutex_storage_t *mutex); /* returns 0 on success, non-zero otherwise */
+MY_MUTEX_EXPORT int mutex_storage_trylock(mutex_storage_t *mutex); /* returns 0 if the mutex was acquired without waiting, non-zero otherwise */
+MY_MUTEX_EXPORT int mutex_storage_timedlock(mutex_storage_t *mutex, unsigned long milliseconds); /* returns 0 if the mutex was acquired in time, non-zero otherwise */
+
+MY_MUTEX_EXPORT int rwlock_init(rwlock_storage_t *rwlock); /* returns 0 on success, non-zero otherwise */
+MY_MUTEX_EXPORT void rwlock_deinit(rwlock_storage_t *rwlock);
+MY_MUTEX_EXPORT int rwlock_lock(rwlock_storage_t *rwlock); /* for writing, returns 0 on success, non-zero otherwise */
+MY_MUTEX_EXPORT int rwlock_unlock(rwlock_storage_t *rwlock); /* returns 0 on success, non-zero otherwise */
+MY_MUTEX_EXPORT int rwlock_lock_shared(rwlock_storage_t *rwlock); /* for reading, returns 0 on success, non-zero otherwise */
+MY_MUTEX_EXPORT int rwlock_unlock_shared(rwlock_storage_t *rwlock); /* returns 0 on success, non-zero otherwise */
 
 #ifdef __cplusplus
 }
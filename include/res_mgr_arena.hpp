@@ -0,0 +1,288 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2026 MH Lim
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// requires C++11
+
+#ifndef RESOURCE_MANAGER_ARENA_HPP
+#define RESOURCE_MANAGER_ARENA_HPP
+
+#include "res_mgr_config.hpp"
+#include "res_mgr_resource.hpp"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+namespace res_mgr {
+
+namespace detail {
+
+struct ArenaRegionFunctor
+{
+	static unsigned char* allocate(std::size_t size)
+	{
+		return static_cast<unsigned char*>(std::malloc(size));
+	}
+
+	void operator()(unsigned char* region)
+	{
+		std::free(region);
+	}
+
+	bool operator()(unsigned char* region, unsigned char* invalid_region) { return (region != invalid_region); }
+};
+
+typedef Resource<unsigned char*, nullptr, ArenaRegionFunctor> ArenaRegion;
+
+// The header of a region that is allocated when the first region is full, the memory handed out follows the header.
+struct ArenaOverflowRegion
+{
+	ArenaOverflowRegion* previous;
+	std::size_t size; // including the header
+};
+
+} // namespace
+
+struct ArenaStats
+{
+	std::size_t capacity;     // number of bytes in all regions
+	std::size_t used;         // number of bytes handed out, including the padding for alignment
+	std::size_t region_count; // number of regions, 1 unless the first region has overflowed
+	std::size_t allocations;  // number of allocations since the construction or the last reset()
+};
+
+/*
+A memory arena, i.e. a monotonic buffer: a large region from which memory is handed out by advancing a pointer.
+Memory is not returned one allocation at a time, all of it is released at once by reset() or by the destructor,
+so the objects allocated from an arena must not need their destructors to be called, or must be destroyed by the caller.
+The memory is not initialized.
+
+When the first region is full, further regions are allocated, each at least twice as large as the previous one.
+reset() releases them and, if there were any, replaces the first region with one as large as all regions together,
+so an arena that is reset after every request stops allocating once it has seen the largest request.
+
+An arena is not thread safe and cannot be copied or moved, since allocators and allocated objects refer to it.
+
+e.g.
+res_mgr::Arena arena(256U * 1024U);
+for (;;) {
+	Request* request = new (arena.allocate(sizeof(Request), alignof(Request))) Request;
+	std::vector<int, res_mgr::ArenaAllocator<int> > values((res_mgr::ArenaAllocator<int>(arena)));
+	...
+	arena.reset();
+}
+*/
+class Arena
+{
+public:
+	static const std::size_t default_alignment = alignof(std::max_align_t);
+	static const std::size_t default_capacity = 65536U;
+
+	// Throws std::bad_alloc if the first region cannot be allocated.
+	explicit Arena(std::size_t capacity = default_capacity) :
+		m_region(detail::ArenaRegionFunctor::allocate((capacity > 0U) ? capacity : 1U)),
+		m_capacity((capacity > 0U) ? capacity : 1U), m_overflow(NULL), m_overflow_capacity(0U), m_overflow_used(0U), m_allocations(0U)
+	{
+		if (!m_region.is_valid())
+			throw std::bad_alloc();
+		rewind();
+	}
+
+	// The first region is released by m_region.
+	~Arena()
+	{
+		release_overflow();
+	}
+
+	// The alignment must be a power of two, throws std::bad_alloc on failure.
+	void* allocate(std::size_t size, std::size_t alignment = default_alignment)
+	{
+		assert(alignment > 0U && (alignment & (alignment - 1U)) == 0U);
+		const std::uintptr_t current = reinterpret_cast<std::uintptr_t>(m_current);
+		const std::uintptr_t aligned = (current + alignment - 1U) & ~static_cast<std::uintptr_t>(alignment - 1U);
+		const std::uintptr_t end = reinterpret_cast<std::uintptr_t>(m_end);
+		if (aligned > end || size > end - aligned)
+			return allocate_from_new_region(size, alignment);
+
+		m_current = reinterpret_cast<unsigned char*>(aligned + size);
+		++m_allocations;
+		return reinterpret_cast<void*>(aligned);
+	}
+
+	// Releases all the memory handed out, see above.
+	void reset() RES_MGR_NOEXCEPT
+	{
+		if (m_overflow != NULL) {
+			const std::size_t capacity = m_capacity + m_overflow_capacity;
+			release_overflow();
+			// The first region is kept if the larger one cannot be allocated.
+			unsigned char* region = detail::ArenaRegionFunctor::allocate(capacity);
+			if (region != NULL) {
+				m_region = region;
+				m_capacity = capacity;
+			}
+		}
+		m_allocations = 0U;
+		rewind();
+	}
+
+	ArenaStats get_stats() const
+	{
+		ArenaStats stats;
+		stats.capacity = m_capacity + m_overflow_capacity;
+		stats.used = m_overflow_used + static_cast<std::size_t>(m_current - m_begin);
+		stats.region_count = 1U;
+		for (const detail::ArenaOverflowRegion* region = m_overflow; region != NULL; region = region->previous)
+			++stats.region_count;
+		stats.allocations = m_allocations;
+		return stats;
+	}
+
+private:
+	static const std::size_t overflow_header_size =
+		(sizeof(detail::ArenaOverflowRegion) + default_alignment - 1U) / default_alignment * default_alignment;
+
+	Arena(const Arena&);
+	Arena& operator=(const Arena&);
+
+	void rewind()
+	{
+		m_begin = m_region.get();
+		m_current = m_begin;
+		m_end = m_begin + m_capacity;
+		m_overflow_used = 0U;
+	}
+
+	void* allocate_from_new_region(std::size_t size, std::size_t alignment)
+	{
+		const std::size_t padding = (alignment > default_alignment) ? alignment : 0U;
+		if (size > std::numeric_limits<std::size_t>::max() - overflow_header_size - padding)
+			throw std::bad_alloc();
+
+		const std::size_t previous_size = (m_overflow != NULL) ? m_overflow->size : m_capacity;
+		std::size_t region_size = overflow_header_size + padding + size;
+		if (previous_size <= std::numeric_limits<std::size_t>::max() / 2U && region_size < 2U * previous_size)
+			region_size = 2U * previous_size;
+
+		detail::ArenaOverflowRegion* region = reinterpret_cast<detail::ArenaOverflowRegion*>(detail::ArenaRegionFunctor::allocate(region_size));
+		if (region == NULL)
+			throw std::bad_alloc();
+
+		region->previous = m_overflow;
+		region->size = region_size;
+		m_overflow = region;
+		m_overflow_capacity += region_size;
+		m_overflow_used += static_cast<std::size_t>(m_current - m_begin);
+		m_begin = reinterpret_cast<unsigned char*>(region) + overflow_header_size;
+		m_current = m_begin;
+		m_end = reinterpret_cast<unsigned char*>(region) + region_size;
+		return allocate(size, alignment);
+	}
+
+	void release_overflow()
+	{
+		detail::ArenaRegionFunctor release_;
+		while (m_overflow != NULL) {
+			detail::ArenaOverflowRegion* previous = m_overflow->previous;
+			release_(reinterpret_cast<unsigned char*>(m_overflow));
+			m_overflow = previous;
+		}
+		m_overflow_capacity = 0U;
+	}
+
+	detail::ArenaRegion m_region;            // the first region
+	std::size_t m_capacity;                  // size of the first region
+	detail::ArenaOverflowRegion* m_overflow; // the last region allocated after the first one was full, NULL for none
+	std::size_t m_overflow_capacity;
+	std::size_t m_overflow_used;             // bytes handed out from the regions before the current one
+	std::size_t m_allocations;
+
+	// The region that memory is currently handed out from.
+	unsigned char* m_begin;
+	unsigned char* m_current;
+	unsigned char* m_end;
+};
+
+/*
+An allocator for STL containers which allocates from an Arena.
+deallocate() does nothing, the memory is released with the arena, which must outlive the container.
+
+e.g.
+res_mgr::Arena arena;
+std::vector<int, res_mgr::ArenaAllocator<int> > values((res_mgr::ArenaAllocator<int>(arena)));
+*/
+template<typename T>
+class ArenaAllocator
+{
+public:
+	typedef T value_type;
+
+	explicit ArenaAllocator(Arena& arena) RES_MGR_NOEXCEPT : m_arena(&arena)
+	{
+	}
+
+	template<typename U>
+	ArenaAllocator(const ArenaAllocator<U>& src) RES_MGR_NOEXCEPT : m_arena(src.get_arena())
+	{
+	}
+
+	T* allocate(std::size_t count)
+	{
+		if (count > std::numeric_limits<std::size_t>::max() / sizeof(T))
+			throw std::bad_alloc();
+		return static_cast<T*>(m_arena->allocate(count * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T*, std::size_t) RES_MGR_NOEXCEPT
+	{
+	}
+
+	Arena* get_arena() const RES_MGR_NOEXCEPT
+	{
+		return m_arena;
+	}
+
+private:
+	Arena* m_arena;
+};
+
+template<typename T, typename U>
+bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) RES_MGR_NOEXCEPT
+{
+	return (lhs.get_arena() == rhs.get_arena());
+}
+
+template<typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) RES_MGR_NOEXCEPT
+{
+	return (lhs.get_arena() != rhs.get_arena());
+}
+
+} // namespace
+
+#endif
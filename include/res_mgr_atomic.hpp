@@ -27,11 +27,28 @@ SOFTWARE.
 #ifndef RESOURCE_MANAGER_ATOMIC_HPP
 #define RESOURCE_MANAGER_ATOMIC_HPP
 
+#include "res_mgr_config.hpp"
 #include <cassert>
 #include <cstddef>
 
+#ifdef RES_MGR_HAS_CXX11
+#include <atomic>
+#endif
+
 namespace res_mgr {
 
+/*
+Memory orders accepted by the atomic functions below, they have the same meaning as the std::memory_order values.
+Functions without a memory order parameter are sequentially consistent.
+*/
+enum memory_order {
+	memory_order_relaxed,
+	memory_order_acquire,
+	memory_order_release,
+	memory_order_acq_rel,
+	memory_order_seq_cst
+};
+
 /*
 Template parameters:
 1) IntegerType: an integer type, e.g. int, unsigned int, long, unsigned long, etc.
@@ -43,75 +60,268 @@ Template parameters:
    IntegerType operator+=(IntegerType): atomic addition
    IntegerType operator-=(IntegerType): atomic subtraction
    IntegerType operator&=(IntegerType): atomic bitwise AND
-   IntegerType operator!=(IntegerType): atomic bitwise OR
+   IntegerType operator|=(IntegerType): atomic bitwise OR
    IntegerType operator^=(IntegerType): atomic bitwise XOR
+   and the following member functions, which are only needed by atomic_exchange, atomic_compare_exchange_* and atomic_fetch_and/or/xor
+   IntegerType exchange(IntegerType): atomic exchange, returns the previous value
+   bool compare_exchange_weak(IntegerType& expected, IntegerType desired): see std::atomic
+   bool compare_exchange_strong(IntegerType& expected, IntegerType desired): see std::atomic
 
 AtomicType can be OS specific or std::atomic<IntegerType>.
+The operations on std::atomic use the given memory order.
+The operations on other types go through the operators and member functions above, which are assumed to be sequentially consistent,
+a different behavior can be provided by specializing atomic_traits.
 */
 template<typename IntegerType, class AtomicType>
-inline IntegerType atomic_increment(AtomicType *p_atomic)
+struct atomic_traits
+{
+	static IntegerType increment(AtomicType *p_atomic, memory_order) { return ++(*p_atomic); }
+	static IntegerType decrement(AtomicType *p_atomic, memory_order) { return --(*p_atomic); }
+	static IntegerType load(AtomicType *p_atomic, memory_order) { return static_cast<IntegerType>(*p_atomic); }
+	static void store(AtomicType *p_atomic, IntegerType value, memory_order) { *p_atomic = value; }
+	static IntegerType exchange(AtomicType *p_atomic, IntegerType value, memory_order) { return p_atomic->exchange(value); }
+
+	static bool compare_exchange_weak(AtomicType *p_atomic, IntegerType& expected, IntegerType desired, memory_order, memory_order)
+	{
+		return p_atomic->compare_exchange_weak(expected, desired);
+	}
+
+	static bool compare_exchange_strong(AtomicType *p_atomic, IntegerType& expected, IntegerType desired, memory_order, memory_order)
+	{
+		return p_atomic->compare_exchange_strong(expected, desired);
+	}
+
+	// return the new value
+	static IntegerType add(AtomicType *p_atomic, IntegerType value, memory_order) { return (*p_atomic += value); }
+	static IntegerType sub(AtomicType *p_atomic, IntegerType value, memory_order) { return (*p_atomic -= value); }
+	static IntegerType bitwise_and(AtomicType *p_atomic, IntegerType value, memory_order) { return (*p_atomic &= value); }
+	static IntegerType bitwise_or(AtomicType *p_atomic, IntegerType value, memory_order) { return (*p_atomic |= value); }
+	static IntegerType bitwise_xor(AtomicType *p_atomic, IntegerType value, memory_order) { return (*p_atomic ^= value); }
+
+	// return the previous value
+	static IntegerType fetch_add(AtomicType *p_atomic, IntegerType value, memory_order) { return static_cast<IntegerType>((*p_atomic += value) - value); }
+	static IntegerType fetch_sub(AtomicType *p_atomic, IntegerType value, memory_order) { return static_cast<IntegerType>((*p_atomic -= value) + value); }
+
+	static IntegerType fetch_and(AtomicType *p_atomic, IntegerType value, memory_order)
+	{
+		IntegerType expected = static_cast<IntegerType>(*p_atomic);
+		while (!p_atomic->compare_exchange_weak(expected, static_cast<IntegerType>(expected & value))) {}
+		return expected;
+	}
+
+	static IntegerType fetch_or(AtomicType *p_atomic, IntegerType value, memory_order)
+	{
+		IntegerType expected = static_cast<IntegerType>(*p_atomic);
+		while (!p_atomic->compare_exchange_weak(expected, static_cast<IntegerType>(expected | value))) {}
+		return expected;
+	}
+
+	static IntegerType fetch_xor(AtomicType *p_atomic, IntegerType value, memory_order)
+	{
+		IntegerType expected = static_cast<IntegerType>(*p_atomic);
+		while (!p_atomic->compare_exchange_weak(expected, static_cast<IntegerType>(expected ^ value))) {}
+		return expected;
+	}
+
+	// The operations above are sequentially consistent, no fence is needed.
+	static void fence(memory_order) {}
+};
+
+#ifdef RES_MGR_HAS_CXX11
+template<typename IntegerType, typename ValueType>
+struct atomic_traits<IntegerType, std::atomic<ValueType> >
+{
+	typedef std::atomic<ValueType> AtomicType;
+
+	static std::memory_order to_std(memory_order order)
+	{
+		switch (order) {
+		case memory_order_relaxed: return std::memory_order_relaxed;
+		case memory_order_acquire: return std::memory_order_acquire;
+		case memory_order_release: return std::memory_order_release;
+		case memory_order_acq_rel: return std::memory_order_acq_rel;
+		default: return std::memory_order_seq_cst;
+		}
+	}
+
+	static IntegerType increment(AtomicType *p_atomic, memory_order order) { return static_cast<IntegerType>(p_atomic->fetch_add(1, to_std(order)) + 1); }
+	static IntegerType decrement(AtomicType *p_atomic, memory_order order) { return static_cast<IntegerType>(p_atomic->fetch_sub(1, to_std(order)) - 1); }
+	static IntegerType load(AtomicType *p_atomic, memory_order order) { return static_cast<IntegerType>(p_atomic->load(to_std(order))); }
+	static void store(AtomicType *p_atomic, IntegerType value, memory_order order) { p_atomic->store(value, to_std(order)); }
+	static IntegerType exchange(AtomicType *p_atomic, IntegerType value, memory_order order) { return static_cast<IntegerType>(p_atomic->exchange(value, to_std(order))); }
+
+	static bool compare_exchange_weak(AtomicType *p_atomic, IntegerType& expected, IntegerType desired, memory_order success, memory_order failure)
+	{
+		ValueType value = expected;
+		const bool exchanged = p_atomic->compare_exchange_weak(value, desired, to_std(success), to_std(failure));
+		expected = static_cast<IntegerType>(value);
+		return exchanged;
+	}
+
+	static bool compare_exchange_strong(AtomicType *p_atomic, IntegerType& expected, IntegerType desired, memory_order success, memory_order failure)
+	{
+		ValueType value = expected;
+		const bool exchanged = p_atomic->compare_exchange_strong(value, desired, to_std(success), to_std(failure));
+		expected = static_cast<IntegerType>(value);
+		return exchanged;
+	}
+
+	static IntegerType add(AtomicType *p_atomic, IntegerType value, memory_order order) { return static_cast<IntegerType>(p_atomic->fetch_add(value, to_std(order)) + value); }
+	static IntegerType sub(AtomicType *p_atomic, IntegerType value, memory_order order) { return static_cast<IntegerType>(p_atomic->fetch_sub(value, to_std(order)) - value); }
+	static IntegerType bitwise_and(AtomicType *p_atomic, IntegerType value, memory_order order) { return static_cast<IntegerType>(p_atomic->fetch_and(value, to_std(order)) & value); }
+	static IntegerType bitwise_or(AtomicType *p_atomic, IntegerType value, memory_order order) { return static_cast<IntegerType>(p_atomic->fetch_or(value, to_std(order)) | value); }
+	static IntegerType bitwise_xor(AtomicType *p_atomic, IntegerType value, memory_order order) { return static_cast<IntegerType>(p_atomic->fetch_xor(value, to_std(order)) ^ value); }
+
+	static IntegerType fetch_add(AtomicType *p_atomic, IntegerType value, memory_order order) { return static_cast<IntegerType>(p_atomic->fetch_add(value, to_std(order))); }
+	static IntegerType fetch_sub(AtomicType *p_atomic, IntegerType value, memory_order order) { return static_cast<IntegerType>(p_atomic->fetch_sub(value, to_std(order))); }
+	static IntegerType fetch_and(AtomicType *p_atomic, IntegerType value, memory_order order) { return static_cast<IntegerType>(p_atomic->fetch_and(value, to_std(order))); }
+	static IntegerType fetch_or(AtomicType *p_atomic, IntegerType value, memory_order order) { return static_cast<IntegerType>(p_atomic->fetch_or(value, to_std(order))); }
+	static IntegerType fetch_xor(AtomicType *p_atomic, IntegerType value, memory_order order) { return static_cast<IntegerType>(p_atomic->fetch_xor(value, to_std(order))); }
+
+	static void fence(memory_order order) { std::atomic_thread_fence(to_std(order)); }
+};
+#endif
+
+// returns the new value
+template<typename IntegerType, class AtomicType>
+inline IntegerType atomic_increment(AtomicType *p_atomic, memory_order order = memory_order_seq_cst)
+{
+	assert(p_atomic != NULL);
+	return atomic_traits<IntegerType, AtomicType>::increment(p_atomic, order);
+}
+
+// returns the new value
+template<typename IntegerType, class AtomicType>
+inline IntegerType atomic_decrement(AtomicType *p_atomic, memory_order order = memory_order_seq_cst)
 {
 	assert(p_atomic != NULL);
-	return ++(*p_atomic);
+	return atomic_traits<IntegerType, AtomicType>::decrement(p_atomic, order);
 }
 
 template<typename IntegerType, class AtomicType>
-inline IntegerType atomic_decrement(AtomicType *p_atomic)
+inline IntegerType atomic_load(AtomicType *p_atomic, memory_order order = memory_order_seq_cst)
 {
 	assert(p_atomic != NULL);
-	return --(*p_atomic);
+	return atomic_traits<IntegerType, AtomicType>::load(p_atomic, order);
 }
 
+// A plain store, use atomic_exchange to get the previous value.
 template<typename IntegerType, class AtomicType>
-inline IntegerType atomic_load(AtomicType *p_atomic)
+inline void atomic_store(AtomicType *p_atomic, IntegerType new_value, memory_order order = memory_order_seq_cst)
 {
 	assert(p_atomic != NULL);
-	return static_cast<IntegerType>(*p_atomic);
+	atomic_traits<IntegerType, AtomicType>::store(p_atomic, new_value, order);
 }
 
 // returns the previous value
 template<typename IntegerType, class AtomicType>
-inline IntegerType atomic_store(AtomicType *p_atomic, IntegerType new_value)
+inline IntegerType atomic_exchange(AtomicType *p_atomic, IntegerType new_value, memory_order order = memory_order_seq_cst)
+{
+	assert(p_atomic != NULL);
+	return atomic_traits<IntegerType, AtomicType>::exchange(p_atomic, new_value, order);
+}
+
+/*
+Replaces the value with desired if it is equal to expected and returns true.
+Otherwise, expected is updated with the current value and false is returned.
+The weak form may fail spuriously and should be called in a loop.
+The failure order must not be memory_order_release or memory_order_acq_rel.
+*/
+template<typename IntegerType, class AtomicType>
+inline bool atomic_compare_exchange_weak(AtomicType *p_atomic, IntegerType& expected, IntegerType desired,
+	memory_order success = memory_order_seq_cst, memory_order failure = memory_order_seq_cst)
+{
+	assert(p_atomic != NULL);
+	return atomic_traits<IntegerType, AtomicType>::compare_exchange_weak(p_atomic, expected, desired, success, failure);
+}
+
+template<typename IntegerType, class AtomicType>
+inline bool atomic_compare_exchange_strong(AtomicType *p_atomic, IntegerType& expected, IntegerType desired,
+	memory_order success = memory_order_seq_cst, memory_order failure = memory_order_seq_cst)
 {
 	assert(p_atomic != NULL);
-	const IntegerType old_value = static_cast<IntegerType>(*p_atomic);
-	*p_atomic = new_value;
-	return old_value;
+	return atomic_traits<IntegerType, AtomicType>::compare_exchange_strong(p_atomic, expected, desired, success, failure);
 }
 
+// atomic_add, atomic_sub, atomic_and, atomic_or and atomic_xor return the new value
+
 template<typename IntegerType, class AtomicType>
-inline IntegerType atomic_add(AtomicType *p_atomic, IntegerType value)
+inline IntegerType atomic_add(AtomicType *p_atomic, IntegerType value, memory_order order = memory_order_seq_cst)
 {
 	assert(p_atomic != NULL);
-	return (*p_atomic += value);
+	return atomic_traits<IntegerType, AtomicType>::add(p_atomic, value, order);
 }
 
 template<typename IntegerType, class AtomicType>
-inline IntegerType atomic_sub(AtomicType *p_atomic, IntegerType value)
+inline IntegerType atomic_sub(AtomicType *p_atomic, IntegerType value, memory_order order = memory_order_seq_cst)
 {
 	assert(p_atomic != NULL);
-	return (*p_atomic -= value);
+	return atomic_traits<IntegerType, AtomicType>::sub(p_atomic, value, order);
 }
 
 template<typename IntegerType, class AtomicType>
-inline IntegerType atomic_and(AtomicType *p_atomic, IntegerType value)
+inline IntegerType atomic_and(AtomicType *p_atomic, IntegerType value, memory_order order = memory_order_seq_cst)
 {
 	assert(p_atomic != NULL);
-	return (*p_atomic &= value);
+	return atomic_traits<IntegerType, AtomicType>::bitwise_and(p_atomic, value, order);
 }
 
 template<typename IntegerType, class AtomicType>
-inline IntegerType atomic_or(AtomicType *p_atomic, IntegerType value)
+inline IntegerType atomic_or(AtomicType *p_atomic, IntegerType value, memory_order order = memory_order_seq_cst)
 {
 	assert(p_atomic != NULL);
-	return (*p_atomic |= value);
+	return atomic_traits<IntegerType, AtomicType>::bitwise_or(p_atomic, value, order);
 }
 
 template<typename IntegerType, class AtomicType>
-inline IntegerType atomic_xor(AtomicType *p_atomic, IntegerType value)
+inline IntegerType atomic_xor(AtomicType *p_atomic, IntegerType value, memory_order order = memory_order_seq_cst)
 {
 	assert(p_atomic != NULL);
-	return (*p_atomic ^= value);
+	return atomic_traits<IntegerType, AtomicType>::bitwise_xor(p_atomic, value, order);
+}
+
+// atomic_fetch_add, atomic_fetch_sub, atomic_fetch_and, atomic_fetch_or and atomic_fetch_xor return the previous value
+
+template<typename IntegerType, class AtomicType>
+inline IntegerType atomic_fetch_add(AtomicType *p_atomic, IntegerType value, memory_order order = memory_order_seq_cst)
+{
+	assert(p_atomic != NULL);
+	return atomic_traits<IntegerType, AtomicType>::fetch_add(p_atomic, value, order);
+}
+
+template<typename IntegerType, class AtomicType>
+inline IntegerType atomic_fetch_sub(AtomicType *p_atomic, IntegerType value, memory_order order = memory_order_seq_cst)
+{
+	assert(p_atomic != NULL);
+	return atomic_traits<IntegerType, AtomicType>::fetch_sub(p_atomic, value, order);
+}
+
+template<typename IntegerType, class AtomicType>
+inline IntegerType atomic_fetch_and(AtomicType *p_atomic, IntegerType value, memory_order order = memory_order_seq_cst)
+{
+	assert(p_atomic != NULL);
+	return atomic_traits<IntegerType, AtomicType>::fetch_and(p_atomic, value, order);
+}
+
+template<typename IntegerType, class AtomicType>
+inline IntegerType atomic_fetch_or(AtomicType *p_atomic, IntegerType value, memory_order order = memory_order_seq_cst)
+{
+	assert(p_atomic != NULL);
+	return atomic_traits<IntegerType, AtomicType>::fetch_or(p_atomic, value, order);
+}
+
+template<typename IntegerType, class AtomicType>
+inline IntegerType atomic_fetch_xor(AtomicType *p_atomic, IntegerType value, memory_order order = memory_order_seq_cst)
+{
+	assert(p_atomic != NULL);
+	return atomic_traits<IntegerType, AtomicType>::fetch_xor(p_atomic, value, order);
+}
+
+// A fence for the memory operations on the given atomic type, e.g. std::atomic_thread_fence for std::atomic.
+template<typename IntegerType, class AtomicType>
+inline void atomic_fence(memory_order order)
+{
+	atomic_traits<IntegerType, AtomicType>::fence(order);
 }
 
 } // namespace
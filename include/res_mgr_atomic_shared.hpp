@@ -0,0 +1,207 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2026 MH Lim
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// requires C++11
+
+#ifndef RESOURCE_MANAGER_ATOMIC_SHARED_HPP
+#define RESOURCE_MANAGER_ATOMIC_SHARED_HPP
+
+#include "res_mgr_epoch.hpp"
+#include "res_mgr_shared.hpp"
+#include <atomic>
+#include <cstdint>
+
+namespace res_mgr {
+
+/*
+A slot holding a SharedResource, which can be read and replaced by several threads at the same time without a lock.
+The slot points to a node holding a SharedResource. A writer publishes a new node with an atomic exchange
+and retires the old one, which keeps its reference until the readers that may still copy from it have left (see EpochDomain).
+load() copies the SharedResource of the current node within a read-side critical section, so it does not wait for a writer.
+Two resources compare equal if they hold the same resource, see get() of SharedResource.
+Template parameters:
+1) SharedResourceType: a SharedResource type
+
+e.g.
+typedef res_mgr::SharedResource<Config*, nullptr, ConfigFunctor, long, std::atomic<long> > SharedConfig;
+res_mgr::AtomicSharedResource<SharedConfig> current_config;
+
+// reader
+SharedConfig config = current_config.load();
+
+// writer
+current_config.store(SharedConfig(load_config()));
+*/
+template<class SharedResourceType>
+class AtomicSharedResource
+{
+public:
+	typedef typename SharedResourceType::resource_type ResourceType;
+
+	AtomicSharedResource() : m_pNode(NULL), m_pRetired(NULL)
+	{
+	}
+
+	explicit AtomicSharedResource(const SharedResourceType& src) : m_pNode(create_node(src)), m_pRetired(NULL)
+	{
+	}
+
+	// No other thread may use the slot anymore when it is destroyed.
+	~AtomicSharedResource()
+	{
+		EpochDomain::instance().synchronize();
+		delete m_pNode.load(std::memory_order_relaxed);
+		reclaim(true);
+	}
+
+	SharedResourceType load() const
+	{
+		EpochGuard guard;
+		const Node* p_node = m_pNode.load(std::memory_order_acquire);
+		return (p_node != NULL) ? p_node->value : SharedResourceType();
+	}
+
+	void store(const SharedResourceType& desired)
+	{
+		retire(m_pNode.exchange(create_node(desired), std::memory_order_acq_rel));
+	}
+
+	SharedResourceType exchange(const SharedResourceType& desired)
+	{
+		// The replaced node is not deleted before it is retired, so the copy needs no critical section.
+		Node* p_node = m_pNode.exchange(create_node(desired), std::memory_order_acq_rel);
+		const SharedResourceType previous = (p_node != NULL) ? p_node->value : SharedResourceType();
+		retire(p_node);
+		return previous;
+	}
+
+	// Replaces the resource with desired if it holds the expected resource and returns true.
+	// Otherwise expected is set to the current resource and false is returned.
+	bool compare_exchange(SharedResourceType& expected, const SharedResourceType& desired)
+	{
+		Node* p_desired = NULL;
+		Node* p_node = NULL;
+		bool exchanged = false;
+		do
+		{
+			// The critical section keeps the current node from being deleted and reused while it is compared.
+			EpochGuard guard;
+			p_node = m_pNode.load(std::memory_order_acquire);
+			const ResourceType current = (p_node != NULL) ? p_node->value.get() : SharedResourceType::invalid_resource();
+			if (current != expected.get())
+			{
+				delete p_desired;
+				expected = (p_node != NULL) ? p_node->value : SharedResourceType();
+				return false;
+			}
+
+			if (p_desired == NULL)
+				p_desired = create_node(desired);
+			exchanged = m_pNode.compare_exchange_weak(p_node, p_desired, std::memory_order_acq_rel, std::memory_order_relaxed);
+		} while (!exchanged);
+
+		retire(p_node);
+		return true;
+	}
+
+	bool is_lock_free() const
+	{
+		return m_pNode.is_lock_free() && m_pRetired.is_lock_free();
+	}
+
+private:
+	struct Node
+	{
+		explicit Node(const SharedResourceType& src) : value(src), retired_epoch(0U), next(NULL)
+		{
+		}
+
+		SharedResourceType value;
+		std::uint64_t retired_epoch;
+		Node* next;
+	};
+
+	AtomicSharedResource(const AtomicSharedResource&);
+	AtomicSharedResource& operator=(const AtomicSharedResource&);
+
+	// An invalid resource is stored without a node.
+	static Node* create_node(const SharedResourceType& src)
+	{
+		return src.is_valid() ? new Node(src) : NULL;
+	}
+
+	// Pushes a replaced node on the list of retired nodes and deletes the nodes that no reader can see anymore.
+	void retire(Node* p_node)
+	{
+		if (p_node != NULL)
+		{
+			p_node->retired_epoch = EpochDomain::instance().advance();
+			push_retired(p_node, p_node);
+		}
+		reclaim(false);
+	}
+
+	void push_retired(Node* p_first, Node* p_last)
+	{
+		p_last->next = m_pRetired.load(std::memory_order_relaxed);
+		while (!m_pRetired.compare_exchange_weak(p_last->next, p_first, std::memory_order_release, std::memory_order_relaxed)) {}
+	}
+
+	// Takes the whole list, so that only one thread looks at a retired node, and pushes back the nodes that are still visible.
+	void reclaim(bool all)
+	{
+		Node* p_node = m_pRetired.exchange(NULL, std::memory_order_acquire);
+		Node* p_first = NULL;
+		Node* p_last = NULL;
+		EpochDomain& domain = EpochDomain::instance();
+		while (p_node != NULL)
+		{
+			Node* p_next = p_node->next;
+			if (all || domain.is_quiescent(p_node->retired_epoch))
+			{
+				delete p_node;
+			}
+			else
+			{
+				p_node->next = p_first;
+				p_first = p_node;
+				if (p_last == NULL)
+					p_last = p_node;
+			}
+			p_node = p_next;
+		}
+
+		if (p_first != NULL)
+			push_retired(p_first, p_last);
+	}
+
+	std::atomic<Node*> m_pNode;
+	std::atomic<Node*> m_pRetired;
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,55 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2026 MH Lim
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef RESOURCE_MANAGER_CONFIG_HPP
+#define RESOURCE_MANAGER_CONFIG_HPP
+
+/*
+Compiler feature detection shared by the res_mgr headers.
+The headers remain usable with C++98 compilers, features that require C++11 are only enabled when RES_MGR_HAS_CXX11 is defined.
+MSVC does not update __cplusplus unless /Zc:__cplusplus is used, so _MSC_VER is checked as well (Visual Studio 2015 or later).
+*/
+#ifndef RES_MGR_HAS_CXX11
+#if (__cplusplus >= 201103L) || (defined _MSC_VER && _MSC_VER >= 1900)
+#define RES_MGR_HAS_CXX11 1
+#endif
+#endif
+
+// RES_MGR_NOEXCEPT_IF(condition) is noexcept(condition) with C++11 and expands to nothing before C++11.
+#ifdef RES_MGR_HAS_CXX11
+#define RES_MGR_NOEXCEPT noexcept
+#define RES_MGR_NOEXCEPT_IF(condition) noexcept(condition)
+#else
+#define RES_MGR_NOEXCEPT throw()
+#define RES_MGR_NOEXCEPT_IF(condition)
+#endif
+
+// The size of a cache line in bytes, used to place data that is written by different threads on different cache lines.
+#ifndef RES_MGR_CACHE_LINE_SIZE
+#define RES_MGR_CACHE_LINE_SIZE 64
+#endif
+
+#endif
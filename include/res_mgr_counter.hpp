@@ -0,0 +1,236 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2026 MH Lim
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef RESOURCE_MANAGER_COUNTER_HPP
+#define RESOURCE_MANAGER_COUNTER_HPP
+
+#include "res_mgr_atomic.hpp"
+#include "res_mgr_config.hpp"
+#include <cassert>
+#include <cstddef>
+
+#ifdef RES_MGR_HAS_CXX11
+#include <atomic>
+#endif
+
+#if defined RES_MGR_CHECK_THREAD_AFFINITY && defined RES_MGR_HAS_CXX11
+#include <thread>
+#endif
+
+namespace res_mgr {
+
+/*
+A counter for resources that never leave the thread that created them.
+It provides the operators and member functions required from AtomicType by res_mgr_atomic.hpp, but none of them is atomic,
+so it can be used as RefCountAtomicType of SharedResource to make a copy cost a plain increment.
+e.g. SharedResource<int, -1, SocketFunctor, long, NonAtomicCounter<long> >
+
+If RES_MGR_CHECK_THREAD_AFFINITY is defined (requires C++11), the counter remembers the thread that created it
+and every operation asserts that it is called from the same thread.
+*/
+template<typename IntegerType>
+class NonAtomicCounter
+{
+public:
+	NonAtomicCounter(IntegerType value = IntegerType()) : m_value(value)
+	{
+	}
+
+	IntegerType operator++() { check_thread(); return ++m_value; }
+	IntegerType operator--() { check_thread(); return --m_value; }
+	operator IntegerType() const { check_thread(); return m_value; }
+	IntegerType operator=(IntegerType value) { check_thread(); return (m_value = value); }
+	IntegerType operator+=(IntegerType value) { check_thread(); return (m_value += value); }
+	IntegerType operator-=(IntegerType value) { check_thread(); return (m_value -= value); }
+	IntegerType operator&=(IntegerType value) { check_thread(); return (m_value &= value); }
+	IntegerType operator|=(IntegerType value) { check_thread(); return (m_value |= value); }
+	IntegerType operator^=(IntegerType value) { check_thread(); return (m_value ^= value); }
+
+	IntegerType exchange(IntegerType value)
+	{
+		check_thread();
+		const IntegerType old_value = m_value;
+		m_value = value;
+		return old_value;
+	}
+
+	bool compare_exchange_weak(IntegerType& expected, IntegerType desired)
+	{
+		return compare_exchange_strong(expected, desired);
+	}
+
+	bool compare_exchange_strong(IntegerType& expected, IntegerType desired)
+	{
+		check_thread();
+		if (m_value == expected) {
+			m_value = desired;
+			return true;
+		}
+		expected = m_value;
+		return false;
+	}
+
+private:
+	NonAtomicCounter(const NonAtomicCounter&);
+	NonAtomicCounter& operator=(const NonAtomicCounter&);
+
+#if defined RES_MGR_CHECK_THREAD_AFFINITY && defined RES_MGR_HAS_CXX11
+	void check_thread() const
+	{
+		assert(m_thread == std::this_thread::get_id() && "A non-atomic counter is used by a thread that did not create it.");
+	}
+
+	const std::thread::id m_thread = std::this_thread::get_id();
+#else
+	void check_thread() const
+	{
+	}
+#endif
+
+	IntegerType m_value;
+};
+
+#ifdef RES_MGR_HAS_CXX11
+/*
+A std::atomic which takes a whole cache line (RES_MGR_CACHE_LINE_SIZE, see std::hardware_destructive_interference_size),
+so that counters updated by different threads do not share a cache line.
+It can be used wherever std::atomic is used, including as AtomicType of res_mgr_atomic.hpp.
+Objects allocated with operator new are only guaranteed to be aligned to a cache line from C++17 on.
+e.g. res_mgr::atomic_increment<long, res_mgr::PaddedAtomic<long> >(&requests);
+*/
+template<typename ValueType>
+struct alignas(RES_MGR_CACHE_LINE_SIZE) PaddedAtomic : public std::atomic<ValueType>
+{
+	PaddedAtomic(ValueType value = ValueType()) : std::atomic<ValueType>(value)
+	{
+	}
+
+	using std::atomic<ValueType>::operator=;
+};
+
+template<typename IntegerType, typename ValueType>
+struct atomic_traits<IntegerType, PaddedAtomic<ValueType> > : public atomic_traits<IntegerType, std::atomic<ValueType> >
+{
+};
+
+namespace detail {
+
+// A small number identifying the calling thread, the threads are numbered in the order in which they first call it.
+inline std::size_t thread_index()
+{
+	static std::atomic<std::size_t> next_index(0U);
+	static thread_local std::size_t index = next_index.fetch_add(1U, std::memory_order_relaxed);
+	return index;
+}
+
+} // namespace detail
+
+/*
+A counter split into shards on separate cache lines, for counters that are updated far more often than they are read,
+e.g. request or error counters.
+A thread always updates the same shard, the threads are assigned to the shards in turn,
+so as long as there are no more threads than shards, no two threads write to the same cache line.
+Reading the counter adds up all the shards.
+Template parameters:
+1) IntegerType: the integer type of the counter
+2) shard_count: the number of shards, each takes one cache line
+
+It can be used as AtomicType of atomic_increment, atomic_decrement, atomic_add, atomic_sub, atomic_load and atomic_store.
+The value returned by atomic_increment, atomic_decrement, atomic_add and atomic_sub is the value of the shard of the calling thread,
+not the value of the counter, which is returned by atomic_load.
+Updates are relaxed, atomic_load and atomic_store are not atomic with respect to concurrent updates.
+e.g.
+res_mgr::ShardedCounter<long> requests;
+res_mgr::atomic_increment<long, res_mgr::ShardedCounter<long> >(&requests);
+long total = res_mgr::atomic_load<long, res_mgr::ShardedCounter<long> >(&requests);
+*/
+template<typename IntegerType, std::size_t shard_count = 64U>
+class ShardedCounter
+{
+public:
+	ShardedCounter(IntegerType value = IntegerType())
+	{
+		store(value);
+	}
+
+	// Returns the new value of the shard of the calling thread.
+	IntegerType add(IntegerType value)
+	{
+		return static_cast<IntegerType>(get_shard().fetch_add(value, std::memory_order_relaxed) + value);
+	}
+
+	// Returns the new value of the shard of the calling thread.
+	IntegerType sub(IntegerType value)
+	{
+		return static_cast<IntegerType>(get_shard().fetch_sub(value, std::memory_order_relaxed) - value);
+	}
+
+	IntegerType load() const
+	{
+		IntegerType sum = IntegerType();
+		for (std::size_t i = 0U; i < shard_count; ++i)
+			sum = static_cast<IntegerType>(sum + m_shards[i].load(std::memory_order_relaxed));
+		return sum;
+	}
+
+	void store(IntegerType value)
+	{
+		m_shards[0].store(value, std::memory_order_relaxed);
+		for (std::size_t i = 1U; i < shard_count; ++i)
+			m_shards[i].store(IntegerType(), std::memory_order_relaxed);
+	}
+
+private:
+	static_assert(shard_count > 0U, "A sharded counter needs at least one shard.");
+
+	ShardedCounter(const ShardedCounter&);
+	ShardedCounter& operator=(const ShardedCounter&);
+
+	PaddedAtomic<IntegerType>& get_shard()
+	{
+		return m_shards[detail::thread_index() % shard_count];
+	}
+
+	PaddedAtomic<IntegerType> m_shards[shard_count];
+};
+
+template<typename IntegerType, typename ValueType, std::size_t shard_count>
+struct atomic_traits<IntegerType, ShardedCounter<ValueType, shard_count> >
+{
+	typedef ShardedCounter<ValueType, shard_count> AtomicType;
+
+	static IntegerType increment(AtomicType *p_atomic, memory_order) { return static_cast<IntegerType>(p_atomic->add(1)); }
+	static IntegerType decrement(AtomicType *p_atomic, memory_order) { return static_cast<IntegerType>(p_atomic->sub(1)); }
+	static IntegerType load(AtomicType *p_atomic, memory_order) { return static_cast<IntegerType>(p_atomic->load()); }
+	static void store(AtomicType *p_atomic, IntegerType value, memory_order) { p_atomic->store(value); }
+	static IntegerType add(AtomicType *p_atomic, IntegerType value, memory_order) { return static_cast<IntegerType>(p_atomic->add(value)); }
+	static IntegerType sub(AtomicType *p_atomic, IntegerType value, memory_order) { return static_cast<IntegerType>(p_atomic->sub(value)); }
+};
+#endif
+
+} // namespace
+
+#endif
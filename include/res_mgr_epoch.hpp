@@ -0,0 +1,317 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2026 MH Lim
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// requires C++11
+
+#ifndef RESOURCE_MANAGER_EPOCH_HPP
+#define RESOURCE_MANAGER_EPOCH_HPP
+
+#include "res_mgr_config.hpp"
+#include "res_mgr_resource.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace res_mgr {
+
+/*
+Epoch-based reclamation.
+A reader announces the current global epoch in a slot owned by its thread when it enters a read-side critical section
+and clears the slot when it leaves. Entering and leaving only write to the slot of the thread, no shared counter is touched.
+A writer that replaces a resource advances the global epoch and keeps the old resource until every reader
+which may still see it, i.e. every reader that announced an older epoch, has left.
+
+There is a single domain for the whole process, EpochDomain::instance().
+The slots are allocated when a thread enters its first critical section and reused after the thread exits.
+*/
+class EpochDomain
+{
+public:
+	static EpochDomain& instance()
+	{
+		static EpochDomain* domain = new EpochDomain; // never destroyed, readers may still leave during static destruction
+		return *domain;
+	}
+
+	// Enters a read-side critical section, critical sections may be nested.
+	void enter()
+	{
+		Slot* slot = get_thread_slot();
+		if (slot->nesting++ == 0U) {
+			// Acquire, so that a reader that announces the epoch of a writer's advance() sees the resource that writer stored.
+			slot->epoch.store(m_epoch.load(std::memory_order_acquire), std::memory_order_seq_cst);
+			// A store followed by a load may be reordered even if both are sequentially consistent, the fence keeps the loads
+			// made in the critical section from being satisfied before the announcement is visible to the writers.
+			// It pairs with the fence in advance(): either the writer's is_quiescent() sees the announcement,
+			// or the reader sees the resource stored before advance().
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+		}
+	}
+
+	void leave()
+	{
+		Slot* slot = get_thread_slot();
+		if (--slot->nesting == 0U)
+			slot->epoch.store(0U, std::memory_order_release);
+	}
+
+	std::uint64_t get_epoch() const
+	{
+		return m_epoch.load(std::memory_order_seq_cst);
+	}
+
+	// Advances the global epoch and returns the new epoch.
+	// A writer calls it after replacing a resource and before calling is_quiescent(), see enter() for the fence.
+	std::uint64_t advance()
+	{
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		return m_epoch.fetch_add(1U, std::memory_order_seq_cst) + 1U;
+	}
+
+	// Returns true if no reader that announced an epoch older than the given epoch is still in its critical section.
+	bool is_quiescent(std::uint64_t epoch) const
+	{
+		for (Slot* slot = m_slots.load(std::memory_order_acquire); slot != NULL; slot = slot->next) {
+			const std::uint64_t announced = slot->epoch.load(std::memory_order_seq_cst);
+			if (announced != 0U && announced < epoch)
+				return false;
+		}
+		return true;
+	}
+
+	// Waits until all readers that were in a critical section at the time of the call have left.
+	// Must not be called from a critical section.
+	void synchronize()
+	{
+		const std::uint64_t epoch = advance();
+		while (!is_quiescent(epoch))
+			std::this_thread::yield();
+	}
+
+private:
+	// The padding keeps the slots of different threads on different cache lines.
+	struct Slot
+	{
+		std::atomic<std::uint64_t> epoch; // 0 outside of critical sections
+		std::atomic<bool> in_use;
+		std::size_t nesting;              // only used by the owner thread
+		Slot* next;
+		char padding[RES_MGR_CACHE_LINE_SIZE];
+	};
+
+	struct ThreadSlotGuard
+	{
+		Slot* slot;
+
+		ThreadSlotGuard() : slot(NULL)
+		{
+		}
+
+		~ThreadSlotGuard()
+		{
+			if (slot != NULL)
+				slot->in_use.store(false, std::memory_order_release);
+		}
+	};
+
+	EpochDomain() : m_epoch(1U), m_slots(NULL)
+	{
+	}
+
+	Slot* get_thread_slot()
+	{
+		static thread_local ThreadSlotGuard guard;
+		if (guard.slot == NULL)
+			guard.slot = acquire_slot();
+		return guard.slot;
+	}
+
+	// Reuses the slot of a thread that has exited, or adds a new slot to the list. Slots are never freed.
+	Slot* acquire_slot()
+	{
+		for (Slot* slot = m_slots.load(std::memory_order_acquire); slot != NULL; slot = slot->next) {
+			bool in_use = false;
+			if (!slot->in_use.load(std::memory_order_relaxed) &&
+				slot->in_use.compare_exchange_strong(in_use, true, std::memory_order_acquire, std::memory_order_relaxed))
+				return slot;
+		}
+
+		Slot* slot = new Slot;
+		slot->epoch.store(0U, std::memory_order_relaxed);
+		slot->in_use.store(true, std::memory_order_relaxed);
+		slot->nesting = 0U;
+		slot->next = m_slots.load(std::memory_order_relaxed);
+		while (!m_slots.compare_exchange_weak(slot->next, slot, std::memory_order_release, std::memory_order_relaxed)) {}
+		return slot;
+	}
+
+	std::atomic<std::uint64_t> m_epoch;
+	std::atomic<Slot*> m_slots;
+};
+
+// Marks a read-side critical section of the current thread.
+class EpochGuard
+{
+public:
+	EpochGuard()
+	{
+		EpochDomain::instance().enter();
+	}
+
+	~EpochGuard()
+	{
+		EpochDomain::instance().leave();
+	}
+
+private:
+	EpochGuard(const EpochGuard&);
+	EpochGuard& operator=(const EpochGuard&);
+};
+
+/*
+A resource that is read by many threads and replaced from time to time, e.g. a configuration or a lookup table.
+Readers call load() within an EpochGuard and may use the returned resource until the guard is destroyed.
+store() replaces the resource, the old resource is released by the functor after all readers that may still use it have left.
+The old resources are released by later calls of store() or by reclaim(), the destructor releases the remaining ones.
+Template parameters:
+1) ResourceType: the type of the resource being managed, it must be usable with std::atomic, e.g. a pointer or a descriptor.
+2) invalid_value: a value that represents an invalid resource or no resource.
+3) ResourceFunctor: a functor or function class which contains two overloads for operator() (see Resource).
+
+e.g.
+typedef res_mgr::EpochResource<Config*, nullptr, ConfigFunctor> CurrentConfig;
+CurrentConfig config(load_config());
+
+// reader
+{
+	res_mgr::EpochGuard guard;
+	const Config* c = config.load();
+	...
+}
+
+// writer
+config.store(load_config());
+*/
+template<typename ResourceType, ResourceType invalid_value, class ResourceFunctor>
+class EpochResource
+{
+public:
+	explicit EpochResource(ResourceType res = invalid_value, const ResourceFunctor& functor = ResourceFunctor()) :
+		m_resource(res), m_functor(functor)
+	{
+	}
+
+	// No reader may use the resource anymore when it is destroyed.
+	~EpochResource()
+	{
+		EpochDomain::instance().synchronize();
+		release_retired(true);
+		release_resource(m_resource.load(std::memory_order_relaxed));
+	}
+
+	// Must be called within an EpochGuard.
+	ResourceType load() const
+	{
+		return m_resource.load(std::memory_order_acquire);
+	}
+
+	void store(ResourceType res)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		const ResourceType old_resource = m_resource.exchange(res, std::memory_order_seq_cst);
+		if (old_resource != res && is_valid(old_resource))
+			m_retired.push_back(std::make_pair(old_resource, EpochDomain::instance().advance()));
+		release_retired(false);
+	}
+
+	// Releases the old resources which are no longer used by any reader, returns the number of resources released.
+	std::size_t reclaim()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return release_retired(false);
+	}
+
+	// Waits for the readers that may use an old resource and releases all old resources.
+	// Must not be called from a critical section.
+	std::size_t synchronize()
+	{
+		EpochDomain::instance().synchronize();
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return release_retired(true);
+	}
+
+	std::size_t get_retired_count() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_retired.size();
+	}
+
+private:
+	EpochResource(const EpochResource&);
+	EpochResource& operator=(const EpochResource&);
+
+	bool is_valid(ResourceType res)
+	{
+		return m_functor(res, invalid_value);
+	}
+
+	void release_resource(ResourceType res)
+	{
+		if (is_valid(res))
+			m_functor(res);
+	}
+
+	// Called with m_mutex held, or from the destructor.
+	std::size_t release_retired(bool all)
+	{
+		EpochDomain& domain = EpochDomain::instance();
+		std::size_t released = 0U;
+		std::size_t kept = 0U;
+		for (std::size_t i = 0U; i < m_retired.size(); ++i) {
+			if (all || domain.is_quiescent(m_retired[i].second)) {
+				release_resource(m_retired[i].first);
+				++released;
+			} else {
+				m_retired[kept++] = m_retired[i];
+			}
+		}
+		m_retired.resize(kept);
+		return released;
+	}
+
+	std::atomic<ResourceType> m_resource;
+	ResourceFunctor m_functor;
+	mutable std::mutex m_mutex; // serializes the writers
+	std::vector<std::pair<ResourceType, std::uint64_t> > m_retired; // old resources and the epoch in which they were replaced
+};
+
+} // namespace
+
+#endif
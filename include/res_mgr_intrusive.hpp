@@ -0,0 +1,234 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2026 MH Lim
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef RESOURCE_MANAGER_INTRUSIVE_HPP
+#define RESOURCE_MANAGER_INTRUSIVE_HPP
+
+#include "res_mgr_atomic.hpp"
+#include "res_mgr_resource.hpp"
+#include "res_mgr_shared.hpp"
+
+namespace res_mgr {
+/*
+The resource is shared among different instances by using a reference count stored in the resource itself.
+An instance only holds the raw resource (and the functor, which takes no space if it is empty), so it is as large as a pointer.
+The reference count is thread safe, but the resource is not thread safe.
+Template parameters:
+1) ResourceType: a pointer to an object that contains the reference count.
+2) invalid_value: a value that represents an invalid resource or no resource.
+3) ResourceFunctor: a functor or function class which contains two overloads for operator() (see SharedResource).
+	- void operator() (ResourceType resource): a function to release the resource, called after the last reference is released
+	- bool operator() (ResourceType resource, ResourceType invalid_value): a function to compare the resource to an invalid value
+
+The reference count is accessed through the following functions, which are found by argument dependent lookup.
+	- void add_ref(ResourceType resource): increments the reference count
+	- RefCountType release_ref(ResourceType resource): decrements the reference count and returns the new value
+A new object starts with a reference count of 0, it is incremented when the object is assigned to the first instance.
+The functions are provided by IntrusiveRefCounter, the simplest way is to derive the object from it.
+
+e.g.
+struct Message : public res_mgr::IntrusiveRefCounter<long, std::atomic<long> > {
+	char text[100];
+};
+
+struct MessageFunctor {
+	void operator() (Message* message) {
+		delete message;
+	}
+	bool operator() (Message* message, Message* invalid_message) {
+		return (message != invalid_message);
+	}
+};
+
+typedef res_mgr::IntrusiveSharedResource<Message*, nullptr, MessageFunctor> SharedMessage;
+SharedMessage message = new Message;
+*/
+template<typename ResourceType, ResourceType invalid_value, class ResourceFunctor>
+class IntrusiveSharedResource
+{
+public:
+	IntrusiveSharedResource(ResourceType res = invalid_value, const ResourceFunctor& functor = ResourceFunctor()) : m_storage(res, functor)
+	{
+		if (is_valid())
+			add_ref(m_storage.m_resource);
+	}
+
+	IntrusiveSharedResource(const IntrusiveSharedResource& src) : m_storage(src.m_storage.m_resource, src.m_storage.functor())
+	{
+		if (is_valid())
+			add_ref(m_storage.m_resource);
+	}
+
+#ifdef RES_MGR_HAS_CXX11
+	IntrusiveSharedResource(IntrusiveSharedResource&& src) noexcept(detail::is_nothrow_movable<ResourceFunctor>::value) :
+		m_storage(src.m_storage.m_resource, std::move(src.m_storage.functor()))
+	{
+		src.m_storage.m_resource = invalid_value;
+	}
+
+	IntrusiveSharedResource& operator=(IntrusiveSharedResource&& src) noexcept(detail::is_nothrow_movable<ResourceFunctor>::value)
+	{
+		if (this != &src)
+		{
+			release();
+			m_storage.m_resource = src.m_storage.m_resource;
+			m_storage.functor() = std::move(src.m_storage.functor());
+			src.m_storage.m_resource = invalid_value;
+		}
+		return *this;
+	}
+#endif
+
+	~IntrusiveSharedResource()
+	{
+		release();
+	}
+
+	IntrusiveSharedResource& operator=(const IntrusiveSharedResource& src)
+	{
+		if (this != &src)
+		{
+			release();
+			m_storage.m_resource = src.m_storage.m_resource;
+			m_storage.functor() = src.m_storage.functor();
+			if (is_valid())
+				add_ref(m_storage.m_resource);
+		}
+		return *this;
+	}
+
+	IntrusiveSharedResource& operator=(ResourceType res)
+	{
+		if (m_storage.m_resource != res)
+		{
+			release();
+			m_storage.m_resource = res;
+			if (is_valid())
+				add_ref(m_storage.m_resource);
+		}
+		return *this;
+	}
+
+	void release()
+	{
+		if (is_valid())
+		{
+			if (0 == release_ref(m_storage.m_resource))
+				m_storage.functor()(m_storage.m_resource);
+			m_storage.m_resource = invalid_value;
+		}
+	}
+
+	ResourceType get() const
+	{
+		return m_storage.m_resource;
+	}
+
+	ResourceFunctor& get_functor()
+	{
+		return m_storage.functor();
+	}
+
+	const ResourceFunctor& get_functor() const
+	{
+		return m_storage.functor();
+	}
+
+	bool is_valid() const
+	{
+		return m_storage.functor()(m_storage.m_resource, invalid_value);
+	}
+
+	void swap(IntrusiveSharedResource& src)
+	{
+		if (this != &src)
+		{
+			ResourceType temp = m_storage.m_resource;
+			m_storage.m_resource = src.m_storage.m_resource;
+			src.m_storage.m_resource = temp;
+			m_storage.swap_functor(src.m_storage);
+		}
+	}
+
+private:
+	detail::ResourceStorage<ResourceType, ResourceFunctor> m_storage;
+};
+
+/*
+A base class which provides the reference count and the functions used by IntrusiveSharedResource.
+The reference count is placed at the beginning of the object, so it shares a cache line with the first members of the object.
+Copying an object does not copy its reference count, the copy starts without any reference.
+Template parameters:
+1) RefCountType: internal integer type for the reference count variable, e.g. int
+2) RefCountAtomicType: atomic type for the reference count variable, e.g. std::atomic<int> (see res_mgr_atomic.hpp)
+3) RefCountPolicy: a class which updates the reference count variable, RelaxedRefCountPolicy by default (see SharedResource)
+*/
+template<typename RefCountType, typename RefCountAtomicType, class RefCountPolicy = RelaxedRefCountPolicy<RefCountType, RefCountAtomicType> >
+class IntrusiveRefCounter
+{
+public:
+	RefCountType get_refcount() const
+	{
+		return atomic_load<RefCountType, RefCountAtomicType>(&m_refcount, memory_order_relaxed);
+	}
+
+	friend void add_ref(const IntrusiveRefCounter* p)
+	{
+		RefCountPolicy::increment(&(p->m_refcount));
+	}
+
+	friend RefCountType release_ref(const IntrusiveRefCounter* p)
+	{
+		return RefCountPolicy::decrement(&(p->m_refcount));
+	}
+
+protected:
+	IntrusiveRefCounter()
+	{
+		m_refcount = 0;
+	}
+
+	IntrusiveRefCounter(const IntrusiveRefCounter&)
+	{
+		m_refcount = 0;
+	}
+
+	IntrusiveRefCounter& operator=(const IntrusiveRefCounter&)
+	{
+		return *this;
+	}
+
+	~IntrusiveRefCounter()
+	{
+	}
+
+private:
+	mutable RefCountAtomicType m_refcount;
+};
+
+} // namespace
+
+#endif
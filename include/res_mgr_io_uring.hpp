@@ -0,0 +1,727 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2026 MH Lim
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// requires C++11 and POSIX, io_uring is used on Linux 5.6 or later
+
+#ifndef RESOURCE_MANAGER_IO_URING_HPP
+#define RESOURCE_MANAGER_IO_URING_HPP
+
+#include "res_mgr_config.hpp"
+#include "res_mgr_resource.hpp"
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#if defined __linux__ && defined __has_include
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#define RES_MGR_HAS_IO_URING
+#endif
+#endif
+
+#ifdef RES_MGR_HAS_IO_URING
+// The system call numbers are the same on all architectures except alpha.
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+#endif
+
+namespace res_mgr {
+
+struct DescriptorFunctor
+{
+	void operator()(int fd) { ::close(fd); }
+
+	bool operator()(int fd, int invalid_fd) { return (fd > invalid_fd); }
+};
+
+// A file descriptor which is closed when the object is destroyed.
+typedef Resource<int, -1, DescriptorFunctor> Descriptor;
+
+namespace detail {
+
+// The size of the mapping is stored in the functor, so that it is known when the mapping is released.
+struct MappingFunctor
+{
+	explicit MappingFunctor(std::size_t number_of_bytes = 0U) : size(number_of_bytes) {}
+
+	void operator()(void* memory) { ::munmap(memory, size); }
+
+	bool operator()(void* memory, void* invalid_memory) { return (memory != invalid_memory); }
+
+	std::size_t size;
+};
+
+typedef Resource<void*, nullptr, MappingFunctor> Mapping;
+
+// Maps memory with mmap(), returns an invalid mapping if it fails.
+inline Mapping map_memory(std::size_t size, int protection, int flags, int fd, off_t offset)
+{
+	void* memory = ::mmap(nullptr, size, protection, flags, fd, offset);
+	return Mapping((memory != MAP_FAILED) ? memory : nullptr, MappingFunctor(size));
+}
+
+} // namespace detail
+
+#ifdef RES_MGR_HAS_IO_URING
+namespace detail {
+
+inline int io_uring_setup(unsigned int entries, io_uring_params* params)
+{
+	return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+inline int io_uring_enter(int ring_fd, unsigned int to_submit, unsigned int min_complete, unsigned int flags)
+{
+	return static_cast<int>(::syscall(__NR_io_uring_enter, ring_fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+inline int io_uring_register(int ring_fd, unsigned int opcode, const void* arg, unsigned int number_of_args)
+{
+	return static_cast<int>(::syscall(__NR_io_uring_register, ring_fd, opcode, arg, number_of_args));
+}
+
+// The kernel reads and writes the ring indices concurrently.
+inline unsigned int load_acquire(const unsigned int* p)
+{
+	return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+inline void store_release(unsigned int* p, unsigned int value)
+{
+	__atomic_store_n(p, value, __ATOMIC_RELEASE);
+}
+
+} // namespace detail
+
+/*
+An io_uring instance, set up with the system calls directly, without liburing.
+The ring descriptor and the mappings of the submission queue, the completion queue and the submission queue entries
+are resources, which are released when the object is destroyed.
+is_valid() returns false if the kernel does not support io_uring or it is disabled, get_error() returns the errno value.
+
+Entries are prepared with get_sqe() and one of the prepare functions below, and submitted together by submit().
+*/
+class IoUring
+{
+public:
+	explicit IoUring(unsigned int entries) :
+		m_error(0), m_sq_head(nullptr), m_sq_tail(nullptr), m_sq_mask(0U), m_sq_entries(0U), m_sq_pending_tail(0U), m_sq_submitted_tail(0U),
+		m_sqes(nullptr), m_cq_head(nullptr), m_cq_tail(nullptr), m_cq_mask(0U), m_cqes(nullptr)
+	{
+		io_uring_params params;
+		std::memset(&params, 0, sizeof(params));
+		m_fd = detail::io_uring_setup(entries, &params);
+		if (!m_fd.is_valid()) {
+			m_error = errno;
+			return;
+		}
+
+		const std::size_t sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+		const std::size_t cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+		const bool single_mapping = (params.features & IORING_FEAT_SINGLE_MMAP) != 0U;
+		const std::size_t ring_size = (single_mapping && cq_ring_size > sq_ring_size) ? cq_ring_size : sq_ring_size;
+		m_sq_ring = detail::map_memory(ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd.get(), IORING_OFF_SQ_RING);
+		if (!single_mapping)
+			m_cq_ring = detail::map_memory(cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd.get(), IORING_OFF_CQ_RING);
+		m_sqe_mapping = detail::map_memory(params.sq_entries * sizeof(io_uring_sqe), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+			m_fd.get(), IORING_OFF_SQES);
+		if (!m_sq_ring.is_valid() || (!single_mapping && !m_cq_ring.is_valid()) || !m_sqe_mapping.is_valid()) {
+			m_error = errno;
+			m_fd.release();
+			return;
+		}
+
+		char* sq_ring = static_cast<char*>(m_sq_ring.get());
+		char* cq_ring = single_mapping ? sq_ring : static_cast<char*>(m_cq_ring.get());
+		m_sq_head = reinterpret_cast<unsigned int*>(sq_ring + params.sq_off.head);
+		m_sq_tail = reinterpret_cast<unsigned int*>(sq_ring + params.sq_off.tail);
+		m_sq_mask = *reinterpret_cast<unsigned int*>(sq_ring + params.sq_off.ring_mask);
+		m_sq_entries = params.sq_entries;
+		m_sq_pending_tail = m_sq_submitted_tail = *m_sq_tail;
+		// Entry i of the submission queue always refers to submission queue entry i.
+		unsigned int* sq_array = reinterpret_cast<unsigned int*>(sq_ring + params.sq_off.array);
+		for (unsigned int i = 0U; i < m_sq_entries; ++i)
+			sq_array[i] = i;
+		m_sqes = static_cast<io_uring_sqe*>(m_sqe_mapping.get());
+
+		m_cq_head = reinterpret_cast<unsigned int*>(cq_ring + params.cq_off.head);
+		m_cq_tail = reinterpret_cast<unsigned int*>(cq_ring + params.cq_off.tail);
+		m_cq_mask = *reinterpret_cast<unsigned int*>(cq_ring + params.cq_off.ring_mask);
+		m_cqes = reinterpret_cast<io_uring_cqe*>(cq_ring + params.cq_off.cqes);
+	}
+
+	bool is_valid() const
+	{
+		return m_fd.is_valid();
+	}
+
+	int get_error() const
+	{
+		return m_error;
+	}
+
+	int get_fd() const
+	{
+		return m_fd.get();
+	}
+
+	unsigned int get_entries() const
+	{
+		return m_sq_entries;
+	}
+
+	// Returns true if the kernel supports all the given operations (IORING_OP_...).
+	bool supports(const int* operations, std::size_t count) const
+	{
+		const unsigned int max_operations = 256U;
+		std::vector<unsigned char> buffer(sizeof(io_uring_probe) + max_operations * sizeof(io_uring_probe_op), 0U);
+		io_uring_probe* probe = reinterpret_cast<io_uring_probe*>(buffer.data());
+		if (detail::io_uring_register(m_fd.get(), IORING_REGISTER_PROBE, probe, max_operations) < 0)
+			return false;
+		for (std::size_t i = 0U; i < count; ++i) {
+			if (operations[i] > probe->last_op || (probe->ops[operations[i]].flags & IO_URING_OP_SUPPORTED) == 0U)
+				return false;
+		}
+		return true;
+	}
+
+	// Returns a cleared submission queue entry, or nullptr if the submission queue is full.
+	io_uring_sqe* get_sqe()
+	{
+		if (m_sq_pending_tail - detail::load_acquire(m_sq_head) >= m_sq_entries)
+			return nullptr;
+		io_uring_sqe* sqe = &m_sqes[m_sq_pending_tail & m_sq_mask];
+		std::memset(sqe, 0, sizeof(*sqe));
+		++m_sq_pending_tail;
+		return sqe;
+	}
+
+	// Submits the prepared entries with a single system call and waits until wait_count operations have completed.
+	// Returns the number of entries submitted, or -errno.
+	int submit(unsigned int wait_count = 0U)
+	{
+		detail::store_release(m_sq_tail, m_sq_pending_tail);
+		const unsigned int to_submit = m_sq_pending_tail - m_sq_submitted_tail;
+		int result;
+		do {
+			result = detail::io_uring_enter(m_fd.get(), to_submit, wait_count, (wait_count > 0U) ? IORING_ENTER_GETEVENTS : 0U);
+		} while (result < 0 && errno == EINTR);
+		if (result < 0)
+			return -errno;
+		m_sq_submitted_tail += static_cast<unsigned int>(result);
+		return result;
+	}
+
+	// Returns the next completion, or nullptr if no operation has completed. seen_cqe() must be called after it has been processed.
+	const io_uring_cqe* peek_cqe() const
+	{
+		const unsigned int head = *m_cq_head;
+		if (head == detail::load_acquire(m_cq_tail))
+			return nullptr;
+		return &m_cqes[head & m_cq_mask];
+	}
+
+	// Waits for the next completion, returns nullptr if waiting fails.
+	const io_uring_cqe* wait_cqe()
+	{
+		const io_uring_cqe* cqe = peek_cqe();
+		while (cqe == nullptr) {
+			if (submit(1U) < 0)
+				return nullptr;
+			cqe = peek_cqe();
+		}
+		return cqe;
+	}
+
+	void seen_cqe()
+	{
+		detail::store_release(m_cq_head, *m_cq_head + 1U);
+	}
+
+private:
+	IoUring(const IoUring&);
+	IoUring& operator=(const IoUring&);
+
+	Descriptor m_fd;
+	int m_error;
+	detail::Mapping m_sq_ring;
+	detail::Mapping m_cq_ring; // invalid if the completion queue shares the mapping of the submission queue
+	detail::Mapping m_sqe_mapping;
+
+	unsigned int* m_sq_head;
+	unsigned int* m_sq_tail;
+	unsigned int m_sq_mask;
+	unsigned int m_sq_entries;
+	unsigned int m_sq_pending_tail;   // the tail including the entries prepared but not yet submitted
+	unsigned int m_sq_submitted_tail; // the tail of the entries consumed by the kernel
+	io_uring_sqe* m_sqes;
+
+	unsigned int* m_cq_head;
+	unsigned int* m_cq_tail;
+	unsigned int m_cq_mask;
+	io_uring_cqe* m_cqes;
+};
+
+inline void prepare_openat(io_uring_sqe* sqe, const char* path, int flags, std::uint64_t user_data)
+{
+	sqe->opcode = IORING_OP_OPENAT;
+	sqe->fd = AT_FDCWD;
+	sqe->addr = reinterpret_cast<std::uintptr_t>(path);
+	sqe->open_flags = static_cast<std::uint32_t>(flags);
+	sqe->user_data = user_data;
+}
+
+inline void prepare_close(io_uring_sqe* sqe, int fd, std::uint64_t user_data)
+{
+	sqe->opcode = IORING_OP_CLOSE;
+	sqe->fd = fd;
+	sqe->user_data = user_data;
+}
+
+// Reads into a buffer. If fixed_file is true, fd is an index into the registered files.
+// If buffer_index is not negative, the buffer must lie within that registered buffer.
+inline void prepare_read(io_uring_sqe* sqe, int fd, bool fixed_file, void* buffer, unsigned int size, std::uint64_t offset, int buffer_index,
+	std::uint64_t user_data)
+{
+	sqe->opcode = (buffer_index >= 0) ? IORING_OP_READ_FIXED : IORING_OP_READ;
+	sqe->flags = fixed_file ? IOSQE_FIXED_FILE : 0U;
+	sqe->fd = fd;
+	sqe->addr = reinterpret_cast<std::uintptr_t>(buffer);
+	sqe->len = size;
+	sqe->off = offset;
+	sqe->buf_index = static_cast<std::uint16_t>((buffer_index >= 0) ? buffer_index : 0);
+	sqe->user_data = user_data;
+}
+
+// Buffers registered with a ring, so that the kernel does not map them for every read. They are unregistered when the object is destroyed.
+class IoUringRegisteredBuffers
+{
+public:
+	IoUringRegisteredBuffers(IoUring& ring, const iovec* buffers, unsigned int count) : m_ring(ring), m_registered(false)
+	{
+		m_registered = (detail::io_uring_register(ring.get_fd(), IORING_REGISTER_BUFFERS, buffers, count) == 0);
+	}
+
+	~IoUringRegisteredBuffers()
+	{
+		if (m_registered)
+			detail::io_uring_register(m_ring.get_fd(), IORING_UNREGISTER_BUFFERS, nullptr, 0U);
+	}
+
+	bool is_valid() const
+	{
+		return m_registered;
+	}
+
+private:
+	IoUringRegisteredBuffers(const IoUringRegisteredBuffers&);
+	IoUringRegisteredBuffers& operator=(const IoUringRegisteredBuffers&);
+
+	IoUring& m_ring;
+	bool m_registered;
+};
+
+// Files registered with a ring, they are referred to by their index with IOSQE_FIXED_FILE. They are unregistered when the object is destroyed.
+// An entry of -1 leaves its index empty.
+class IoUringRegisteredFiles
+{
+public:
+	IoUringRegisteredFiles(IoUring& ring, const int* fds, unsigned int count) : m_ring(ring), m_registered(false)
+	{
+		m_registered = (count > 0U && detail::io_uring_register(ring.get_fd(), IORING_REGISTER_FILES, fds, count) == 0);
+	}
+
+	~IoUringRegisteredFiles()
+	{
+		if (m_registered)
+			detail::io_uring_register(m_ring.get_fd(), IORING_UNREGISTER_FILES, nullptr, 0U);
+	}
+
+	bool is_valid() const
+	{
+		return m_registered;
+	}
+
+private:
+	IoUringRegisteredFiles(const IoUringRegisteredFiles&);
+	IoUringRegisteredFiles& operator=(const IoUringRegisteredFiles&);
+
+	IoUring& m_ring;
+	bool m_registered;
+};
+#endif
+
+/*
+Opens a batch of files, reads ranges of them in blocks and closes them.
+With io_uring, the files of a batch are opened with one submission, registered with the ring and closed with one submission,
+and up to queue_depth blocks are read at the same time directly into registered buffers.
+Without io_uring, e.g. if the kernel is older than 5.6, io_uring is disabled or the system is not Linux,
+the files are opened and closed one at a time and read with pread().
+If a submission fails, the reader falls back to the system calls as well.
+The blocks are passed to the consumer in order, without being copied.
+
+e.g.
+res_mgr::BlockReader reader;
+reader.open(paths, count);
+for (std::size_t i = 0U; i < count; ++i) {
+	if (reader.get_error(i) == 0)
+		reader.read(i, 0U, size, [](const unsigned char* data, std::size_t size) { ... });
+}
+reader.close();
+*/
+class BlockReader
+{
+public:
+	// block_size should be a multiple of the page size, queue_depth is limited to 64.
+	explicit BlockReader(unsigned int queue_depth = 8U, std::size_t block_size = 256U * 1024U) :
+#ifdef RES_MGR_HAS_IO_URING
+		m_ring(ring_entries), m_use_io_uring(false), m_fixed_buffers(false), m_fixed_files(false),
+#endif
+		m_queue_depth((queue_depth == 0U) ? 1U : ((queue_depth > ring_entries) ? ring_entries : queue_depth)), m_block_size(block_size),
+		m_results(m_queue_depth, 0), m_done(m_queue_depth, 0U)
+	{
+		m_buffers = detail::map_memory(m_queue_depth * m_block_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#ifdef RES_MGR_HAS_IO_URING
+		const int operations[] = { IORING_OP_OPENAT, IORING_OP_CLOSE, IORING_OP_READ, IORING_OP_READ_FIXED };
+		m_use_io_uring = m_ring.is_valid() && m_ring.supports(operations, sizeof(operations) / sizeof(operations[0]));
+		if (m_use_io_uring && m_buffers.is_valid()) {
+			std::vector<iovec> buffers(m_queue_depth);
+			for (unsigned int i = 0U; i < m_queue_depth; ++i) {
+				buffers[i].iov_base = get_buffer(i);
+				buffers[i].iov_len = m_block_size;
+			}
+			// Registering fails if the buffers exceed RLIMIT_MEMLOCK on older kernels, they are then used as normal buffers.
+			m_registered_buffers.reset(new IoUringRegisteredBuffers(m_ring, buffers.data(), m_queue_depth));
+			m_fixed_buffers = m_registered_buffers->is_valid();
+		}
+#endif
+	}
+
+	~BlockReader()
+	{
+		close();
+	}
+
+	// Returns false if the buffers could not be allocated.
+	bool is_valid() const
+	{
+		return m_buffers.is_valid();
+	}
+
+	// Returns false if the kernel does not support io_uring or a submission has failed.
+	bool uses_io_uring() const
+	{
+#ifdef RES_MGR_HAS_IO_URING
+		return m_use_io_uring;
+#else
+		return false;
+#endif
+	}
+
+	// Opens the files for reading, the files opened before are closed. get_error() returns the errno value for a file that cannot be opened.
+	void open(const char* const* paths, std::size_t count)
+	{
+		close();
+		m_files.resize(count);
+		m_errors.assign(count, 0);
+#ifdef RES_MGR_HAS_IO_URING
+		if (m_use_io_uring) {
+			open_with_io_uring(paths, count);
+			return;
+		}
+#endif
+		for (std::size_t i = 0U; i < count; ++i) {
+			m_files[i] = ::open(paths[i], O_RDONLY | O_CLOEXEC);
+			if (!m_files[i].is_valid())
+				m_errors[i] = errno;
+		}
+	}
+
+	// Closes the files.
+	void close()
+	{
+#ifdef RES_MGR_HAS_IO_URING
+		m_registered_files.reset();
+		m_fixed_files = false;
+		if (m_use_io_uring) {
+			close_with_io_uring();
+			return;
+		}
+#endif
+		m_files.clear();
+		m_errors.clear();
+	}
+
+	std::size_t get_file_count() const
+	{
+		return m_files.size();
+	}
+
+	int get_fd(std::size_t index) const
+	{
+		return m_files[index].get();
+	}
+
+	int get_error(std::size_t index) const
+	{
+		return m_errors[index];
+	}
+
+	/*
+	Reads length bytes of the file from offset and calls consume(const unsigned char* data, std::size_t size) for every block in order.
+	The data is valid until consume returns. Reading stops at the end of the file.
+	Returns 0, or the errno value if a read fails.
+	*/
+	template<class Consumer>
+	int read(std::size_t index, std::uint64_t offset, std::uint64_t length, Consumer consume)
+	{
+		if (!is_valid())
+			return ENOMEM;
+		if (!m_files[index].is_valid())
+			return EBADF;
+		// No file extends beyond the largest offset, so the range is clamped there and the blocks of the range can be counted without overflow.
+		const std::uint64_t max_offset = static_cast<std::uint64_t>(std::numeric_limits<off_t>::max());
+		if (offset > max_offset)
+			return EINVAL;
+		if (length > max_offset - offset)
+			length = max_offset - offset;
+#ifdef RES_MGR_HAS_IO_URING
+		if (m_use_io_uring)
+			return read_with_io_uring(index, offset, length, consume);
+#endif
+		unsigned char* buffer = get_buffer(0U);
+		while (length > 0U) {
+			const std::size_t size = (length < m_block_size) ? static_cast<std::size_t>(length) : m_block_size;
+			const ssize_t result = ::pread(m_files[index].get(), buffer, size, static_cast<off_t>(offset));
+			if (result < 0) {
+				if (errno == EINTR)
+					continue;
+				return errno;
+			}
+			if (result == 0)
+				break;
+			consume(static_cast<const unsigned char*>(buffer), static_cast<std::size_t>(result));
+			offset += static_cast<std::uint64_t>(result);
+			length -= static_cast<std::uint64_t>(result);
+		}
+		return 0;
+	}
+
+private:
+	static const unsigned int ring_entries = 64U;
+
+	BlockReader(const BlockReader&);
+	BlockReader& operator=(const BlockReader&);
+
+	unsigned char* get_buffer(unsigned int index) const
+	{
+		return static_cast<unsigned char*>(m_buffers.get()) + index * m_block_size;
+	}
+
+#ifdef RES_MGR_HAS_IO_URING
+	void open_with_io_uring(const char* const* paths, std::size_t count)
+	{
+		std::size_t prepared = 0U;
+		std::size_t completed = 0U;
+		std::vector<unsigned char> opened(count, 0U); // 1 if the open of the file has completed, the completions arrive in any order
+		while (completed < count) {
+			io_uring_sqe* sqe;
+			while (prepared < count && prepared - completed < ring_entries && (sqe = m_ring.get_sqe()) != nullptr) {
+				prepare_openat(sqe, paths[prepared], O_RDONLY | O_CLOEXEC, prepared);
+				++prepared;
+			}
+			const bool submitted = (m_ring.submit(1U) >= 0);
+			// The opens that have completed are kept even if the submission failed.
+			for (const io_uring_cqe* cqe = m_ring.peek_cqe(); cqe != nullptr; cqe = m_ring.peek_cqe()) {
+				const std::size_t i = static_cast<std::size_t>(cqe->user_data);
+				if (cqe->res >= 0)
+					m_files[i] = cqe->res;
+				else
+					m_errors[i] = -cqe->res;
+				opened[i] = 1U;
+				m_ring.seen_cqe();
+				++completed;
+			}
+			if (!submitted) {
+				m_use_io_uring = false;
+				break;
+			}
+		}
+		// The files that have not been opened are opened one by one if the ring failed, e.g. the process ran out of memory.
+		for (std::size_t i = 0U; i < count; ++i) {
+			if (opened[i])
+				continue;
+			m_files[i] = ::open(paths[i], O_RDONLY | O_CLOEXEC);
+			if (!m_files[i].is_valid())
+				m_errors[i] = errno;
+		}
+
+		if (m_use_io_uring && count <= 0xFFFFU) {
+			std::vector<int> fds(count);
+			for (std::size_t i = 0U; i < count; ++i)
+				fds[i] = m_files[i].get();
+			m_registered_files.reset(new IoUringRegisteredFiles(m_ring, fds.data(), static_cast<unsigned int>(count)));
+			m_fixed_files = m_registered_files->is_valid();
+		}
+	}
+
+	// The descriptors are detached from their resources and closed by the kernel, the remaining ones are closed by the resources.
+	void close_with_io_uring()
+	{
+		unsigned int in_flight = 0U;
+		for (std::size_t i = 0U; i < m_files.size(); ++i) {
+			if (!m_files[i].is_valid())
+				continue;
+			io_uring_sqe* sqe = m_ring.get_sqe();
+			if (sqe == nullptr) {
+				if (m_ring.submit() < 0)
+					break;
+				sqe = m_ring.get_sqe();
+				if (sqe == nullptr)
+					break;
+			}
+			prepare_close(sqe, m_files[i].detach(), i);
+			++in_flight;
+		}
+		if (in_flight > 0U && m_ring.submit(in_flight) >= 0) {
+			while (in_flight > 0U && m_ring.wait_cqe() != nullptr) {
+				m_ring.seen_cqe();
+				--in_flight;
+			}
+		}
+		m_files.clear();
+		m_errors.clear();
+	}
+
+	template<class Consumer>
+	int read_with_io_uring(std::size_t index, std::uint64_t offset, std::uint64_t length, Consumer consume)
+	{
+		const std::uint64_t block_count = (length + m_block_size - 1U) / m_block_size;
+		std::uint64_t next_block = 0U;     // the next block to be submitted
+		std::uint64_t consumed_block = 0U; // the next block to be consumed
+		unsigned int in_flight = 0U;
+		int error = 0;
+		bool end_of_file = false;
+
+		while (consumed_block < block_count && error == 0 && !end_of_file) {
+			while (next_block < block_count && next_block - consumed_block < m_queue_depth) {
+				io_uring_sqe* sqe = m_ring.get_sqe();
+				if (sqe == nullptr)
+					break;
+				const unsigned int slot = static_cast<unsigned int>(next_block % m_queue_depth);
+				const std::uint64_t block_offset = next_block * m_block_size;
+				const std::uint64_t remaining = length - block_offset;
+				const unsigned int size = static_cast<unsigned int>((remaining < m_block_size) ? remaining : m_block_size);
+				prepare_read(sqe, m_fixed_files ? static_cast<int>(index) : m_files[index].get(), m_fixed_files, get_buffer(slot), size,
+					offset + block_offset, m_fixed_buffers ? static_cast<int>(slot) : -1, next_block);
+				m_done[slot] = 0U;
+				++next_block;
+				++in_flight;
+			}
+
+			if (!m_done[consumed_block % m_queue_depth]) {
+				const int submitted = m_ring.submit(1U);
+				if (submitted < 0) {
+					error = -submitted;
+					m_use_io_uring = false;
+					break;
+				}
+				for (const io_uring_cqe* cqe = m_ring.peek_cqe(); cqe != nullptr; cqe = m_ring.peek_cqe()) {
+					const unsigned int slot = static_cast<unsigned int>(cqe->user_data % m_queue_depth);
+					m_results[slot] = cqe->res;
+					m_done[slot] = 1U;
+					m_ring.seen_cqe();
+					--in_flight;
+				}
+			}
+
+			while (consumed_block < next_block && m_done[consumed_block % m_queue_depth]) {
+				const unsigned int slot = static_cast<unsigned int>(consumed_block % m_queue_depth);
+				const int result = m_results[slot];
+				if (result < 0) {
+					error = -result;
+					break;
+				}
+				if (result > 0)
+					consume(static_cast<const unsigned char*>(get_buffer(slot)), static_cast<std::size_t>(result));
+				++consumed_block;
+				// A short read means that the end of the file has been reached.
+				const std::uint64_t expected = length - (consumed_block - 1U) * m_block_size;
+				if (static_cast<std::uint64_t>(result) < ((expected < m_block_size) ? expected : m_block_size)) {
+					end_of_file = true;
+					break;
+				}
+			}
+		}
+
+		// The reads still in flight write to the buffers, wait for them before the buffers are used again.
+		if (in_flight > 0U && m_ring.submit() >= 0) {
+			while (in_flight > 0U && m_ring.wait_cqe() != nullptr) {
+				m_ring.seen_cqe();
+				--in_flight;
+			}
+		}
+		return error;
+	}
+
+	IoUring m_ring;
+	bool m_use_io_uring;
+	std::unique_ptr<IoUringRegisteredBuffers> m_registered_buffers;
+	std::unique_ptr<IoUringRegisteredFiles> m_registered_files;
+	bool m_fixed_buffers;
+	bool m_fixed_files;
+#endif
+
+	const unsigned int m_queue_depth;
+	const std::size_t m_block_size;
+	std::vector<int> m_results;         // the results of the reads in flight, by buffer
+	std::vector<unsigned char> m_done;  // 1 if the read into the buffer has completed
+	detail::Mapping m_buffers;
+	std::vector<Descriptor> m_files;
+	std::vector<int> m_errors;
+};
+
+} // namespace
+
+#endif
@@ -27,8 +27,23 @@ SOFTWARE.
 #ifndef RESOURCE_MANAGER_LOCK_HPP
 #define RESOURCE_MANAGER_LOCK_HPP
 
+#include "res_mgr_config.hpp"
+
+#ifdef RES_MGR_HAS_CXX11
+#include <chrono>
+#include <cstddef>
+#include <thread>
+#endif
+
 namespace res_mgr {
 
+/*
+A lock which is initialized, acquired, released and deinitialized by functors.
+LockFunctor may provide a second overload, which is required only if try_lock() or try_lock_for() is used.
+	- void operator() (LockType& lock): acquires the lock
+	- bool operator() (LockType& lock, unsigned long timeout_ms): tries to acquire the lock within timeout_ms milliseconds,
+	  0 tries once without waiting, returns true if the lock was acquired
+*/
 template<typename LockType, class InitFunctor, class DeinitFunctor, class LockFunctor, class UnlockFunctor>
 class ResourceLock
 {
@@ -57,6 +72,25 @@ public:
 		unlock(m_lock);
 	}
 
+	bool try_lock()
+	{
+		LockFunctor lock;
+		return lock(m_lock, 0UL);
+	}
+
+#ifdef RES_MGR_HAS_CXX11
+	// The timeout is rounded up to milliseconds.
+	template<class Rep, class Period>
+	bool try_lock_for(const std::chrono::duration<Rep, Period>& timeout)
+	{
+		std::chrono::milliseconds milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(timeout);
+		if (milliseconds < timeout)
+			++milliseconds;
+		LockFunctor lock;
+		return lock(m_lock, (milliseconds.count() > 0) ? static_cast<unsigned long>(milliseconds.count()) : 0UL);
+	}
+#endif
+
 	LockType& get()
 	{
 		return m_lock;
@@ -84,6 +118,178 @@ private:
 	ResourceLock& m_lock;
 };
 
+/*
+A reader-writer lock, which can be held by one writer or by several readers at the same time.
+LockSharedFunctor and UnlockSharedFunctor acquire and release the lock for reading, the other functors are used as in ResourceLock.
+*/
+template<typename LockType, class InitFunctor, class DeinitFunctor, class LockFunctor, class UnlockFunctor, class LockSharedFunctor, class UnlockSharedFunctor>
+class ResourceSharedLock
+{
+public:
+	ResourceSharedLock()
+	{
+		InitFunctor init;
+		init(m_lock);
+	}
+
+	~ResourceSharedLock()
+	{
+		DeinitFunctor deinit;
+		deinit(m_lock);
+	}
+
+	void lock()
+	{
+		LockFunctor lock;
+		lock(m_lock);
+	}
+
+	void unlock()
+	{
+		UnlockFunctor unlock;
+		unlock(m_lock);
+	}
+
+	void lock_shared()
+	{
+		LockSharedFunctor lock_shared;
+		lock_shared(m_lock);
+	}
+
+	void unlock_shared()
+	{
+		UnlockSharedFunctor unlock_shared;
+		unlock_shared(m_lock);
+	}
+
+	LockType& get()
+	{
+		return m_lock;
+	}
+
+private:
+	LockType m_lock;
+};
+
+// Holds a ResourceSharedLock for reading, ResourceLockMechanism holds it for writing.
+template<typename ResourceSharedLock>
+class SharedLockMechanism
+{
+public:
+	explicit SharedLockMechanism(ResourceSharedLock& lock) : m_lock(lock)
+	{
+		m_lock.lock_shared();
+	}
+
+	~SharedLockMechanism()
+	{
+		m_lock.unlock_shared();
+	}
+
+private:
+	ResourceSharedLock& m_lock;
+};
+
+#ifdef RES_MGR_HAS_CXX11
+namespace detail {
+
+// A lock of any type, so that the locks of a ScopedMultiLock can be handled in a loop.
+struct LockableRef
+{
+	void* lock;
+	void (*lock_function)(void*);
+	bool (*try_lock_function)(void*);
+	void (*unlock_function)(void*);
+};
+
+template<class Lockable>
+void lock_lockable(void* lock)
+{
+	static_cast<Lockable*>(lock)->lock();
+}
+
+template<class Lockable>
+bool try_lock_lockable(void* lock)
+{
+	return static_cast<Lockable*>(lock)->try_lock();
+}
+
+template<class Lockable>
+void unlock_lockable(void* lock)
+{
+	static_cast<Lockable*>(lock)->unlock();
+}
+
+template<class Lockable>
+LockableRef make_lockable_ref(Lockable& lock)
+{
+	LockableRef ref = { &lock, &lock_lockable<Lockable>, &try_lock_lockable<Lockable>, &unlock_lockable<Lockable> };
+	return ref;
+}
+
+} // namespace detail
+
+/*
+Holds several locks, e.g. the locks of the two accounts of a transfer, which are acquired without risking a deadlock
+whatever order other threads acquire them in.
+It blocks on one lock and tries the others, if one of them is busy, it releases all the locks it holds,
+yields and starts over by blocking on the busy one.
+The locks must be distinct and provide lock(), try_lock() and unlock(), e.g. ResourceLock.
+
+e.g.
+res_mgr::ScopedMultiLock<Mutex, Mutex> lock(from.mutex, to.mutex);
+*/
+template<class... Locks>
+class ScopedMultiLock
+{
+public:
+	explicit ScopedMultiLock(Locks&... locks) : m_locks{ detail::make_lockable_ref(locks)... }
+	{
+		lock_all();
+	}
+
+	~ScopedMultiLock()
+	{
+		for (std::size_t i = lock_count; i-- > 0U;)
+			m_locks[i].unlock_function(m_locks[i].lock);
+	}
+
+	ScopedMultiLock(const ScopedMultiLock&) = delete;
+	ScopedMultiLock& operator=(const ScopedMultiLock&) = delete;
+
+private:
+	static const std::size_t lock_count = sizeof...(Locks);
+	static_assert(sizeof...(Locks) > 0U, "ScopedMultiLock needs at least one lock.");
+
+	void lock_all()
+	{
+		std::size_t first = 0U;
+		for (;;) {
+			m_locks[first].lock_function(m_locks[first].lock);
+			std::size_t acquired = 1U;
+			while (acquired < lock_count) {
+				const std::size_t i = (first + acquired) % lock_count;
+				if (!m_locks[i].try_lock_function(m_locks[i].lock))
+					break;
+				++acquired;
+			}
+			if (acquired == lock_count)
+				return;
+
+			const std::size_t busy = (first + acquired) % lock_count;
+			while (acquired-- > 0U) {
+				const std::size_t i = (first + acquired) % lock_count;
+				m_locks[i].unlock_function(m_locks[i].lock);
+			}
+			first = busy;
+			std::this_thread::yield();
+		}
+	}
+
+	detail::LockableRef m_locks[sizeof...(Locks)];
+};
+#endif
+
 } // namespace
 
 #endif
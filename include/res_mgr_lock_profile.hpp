@@ -0,0 +1,371 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2026 MH Lim
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// requires C++11
+
+#ifndef RESOURCE_MANAGER_LOCK_PROFILE_HPP
+#define RESOURCE_MANAGER_LOCK_PROFILE_HPP
+
+#include "res_mgr_config.hpp"
+#include "res_mgr_lock.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*
+Lock contention profiling.
+ProfiledLock wraps a lock such as ResourceLock and, if RES_MGR_LOCK_PROFILING is defined, records for every lock
+the number of acquisitions, the number of contended acquisitions, the total and the longest wait and a histogram of hold times.
+A lock is contended if try_lock() fails, so the wrapped lock must provide try_lock().
+The statistics of all live locks are read through LockProfileRegistry, as a snapshot or as text or JSON.
+If RES_MGR_LOCK_PROFILING is not defined, ProfiledLock is the wrapped lock, the name is discarded and nothing is recorded.
+
+e.g.
+typedef res_mgr::ProfiledLock<res_mgr::SpinLock> CounterLock;
+CounterLock lock("counter lock");
+...
+{
+	res_mgr::ResourceLockMechanism<CounterLock> guard(lock);
+	...
+}
+printf("%s", res_mgr::LockProfileRegistry::instance().to_text().c_str());
+*/
+namespace res_mgr {
+
+struct LockStats
+{
+	// Bucket 0 counts hold times below 1 ns, bucket i counts hold times from 2^(i-1) ns to below 2^i ns,
+	// the last bucket also counts all longer hold times.
+	static const std::size_t histogram_size = 40U;
+
+	std::string name;
+	std::uint64_t acquisitions;
+	std::uint64_t contended_acquisitions;
+	std::uint64_t total_wait_ns;
+	std::uint64_t max_wait_ns;
+	std::uint64_t hold_time_histogram[histogram_size];
+
+	LockStats() : acquisitions(0U), contended_acquisitions(0U), total_wait_ns(0U), max_wait_ns(0U), hold_time_histogram()
+	{
+	}
+
+	std::string to_text() const
+	{
+		char line[256];
+		snprintf(line, sizeof(line), "%s: %llu acquisitions, %llu contended, wait total %llu ns, max %llu ns\n",
+			name.c_str(), static_cast<unsigned long long>(acquisitions), static_cast<unsigned long long>(contended_acquisitions),
+			static_cast<unsigned long long>(total_wait_ns), static_cast<unsigned long long>(max_wait_ns));
+		std::string text = line;
+		for (std::size_t i = 0U; i < histogram_size; ++i) {
+			if (hold_time_histogram[i] == 0U)
+				continue;
+			if (i + 1U < histogram_size)
+				snprintf(line, sizeof(line), "  held < %llu ns: %llu\n", 1ULL << i, static_cast<unsigned long long>(hold_time_histogram[i]));
+			else
+				snprintf(line, sizeof(line), "  held >= %llu ns: %llu\n", 1ULL << (i - 1U), static_cast<unsigned long long>(hold_time_histogram[i]));
+			text += line;
+		}
+		return text;
+	}
+
+	std::string to_json() const
+	{
+		char number[32];
+		std::string json = "{\"name\":\"" + escape_json(name) + "\"";
+		snprintf(number, sizeof(number), "%llu", static_cast<unsigned long long>(acquisitions));
+		json += ",\"acquisitions\":" + std::string(number);
+		snprintf(number, sizeof(number), "%llu", static_cast<unsigned long long>(contended_acquisitions));
+		json += ",\"contended_acquisitions\":" + std::string(number);
+		snprintf(number, sizeof(number), "%llu", static_cast<unsigned long long>(total_wait_ns));
+		json += ",\"total_wait_ns\":" + std::string(number);
+		snprintf(number, sizeof(number), "%llu", static_cast<unsigned long long>(max_wait_ns));
+		json += ",\"max_wait_ns\":" + std::string(number);
+		json += ",\"hold_time_histogram\":[";
+		for (std::size_t i = 0U; i < histogram_size; ++i) {
+			snprintf(number, sizeof(number), (i > 0U) ? ",%llu" : "%llu", static_cast<unsigned long long>(hold_time_histogram[i]));
+			json += number;
+		}
+		json += "]}";
+		return json;
+	}
+
+private:
+	static std::string escape_json(const std::string& text)
+	{
+		std::string escaped;
+		for (std::size_t i = 0U; i < text.size(); ++i) {
+			const unsigned char c = static_cast<unsigned char>(text[i]);
+			if (c == '"' || c == '\\') {
+				escaped += '\\';
+				escaped += static_cast<char>(c);
+			} else if (c < 0x20U) {
+				char code[8];
+				snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned int>(c));
+				escaped += code;
+			} else {
+				escaped += static_cast<char>(c);
+			}
+		}
+		return escaped;
+	}
+};
+
+namespace detail {
+
+/*
+The counters of one lock.
+They are only written by the thread holding the lock, so they are updated with plain loads and stores,
+atomic only so that a snapshot can be taken while the lock is in use.
+*/
+class LockProfile
+{
+public:
+	explicit LockProfile(const char* name) : m_name((name != NULL) ? name : ""),
+		m_acquisitions(0U), m_contended_acquisitions(0U), m_total_wait_ns(0U), m_max_wait_ns(0U)
+	{
+		for (std::size_t i = 0U; i < LockStats::histogram_size; ++i)
+			m_hold_time_histogram[i].store(0U, std::memory_order_relaxed);
+	}
+
+	void record_acquisition(bool contended, std::uint64_t wait_ns)
+	{
+		increment(m_acquisitions);
+		if (contended) {
+			increment(m_contended_acquisitions);
+			m_total_wait_ns.store(m_total_wait_ns.load(std::memory_order_relaxed) + wait_ns, std::memory_order_relaxed);
+			if (wait_ns > m_max_wait_ns.load(std::memory_order_relaxed))
+				m_max_wait_ns.store(wait_ns, std::memory_order_relaxed);
+		}
+	}
+
+	void record_hold(std::uint64_t hold_ns)
+	{
+		std::size_t bucket = 0U;
+		while (hold_ns > 0U && bucket + 1U < LockStats::histogram_size) {
+			hold_ns >>= 1;
+			++bucket;
+		}
+		increment(m_hold_time_histogram[bucket]);
+	}
+
+	LockStats get_stats() const
+	{
+		LockStats stats;
+		stats.name = m_name;
+		stats.acquisitions = m_acquisitions.load(std::memory_order_relaxed);
+		stats.contended_acquisitions = m_contended_acquisitions.load(std::memory_order_relaxed);
+		stats.total_wait_ns = m_total_wait_ns.load(std::memory_order_relaxed);
+		stats.max_wait_ns = m_max_wait_ns.load(std::memory_order_relaxed);
+		for (std::size_t i = 0U; i < LockStats::histogram_size; ++i)
+			stats.hold_time_histogram[i] = m_hold_time_histogram[i].load(std::memory_order_relaxed);
+		return stats;
+	}
+
+private:
+	static void increment(std::atomic<std::uint64_t>& counter)
+	{
+		counter.store(counter.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+	}
+
+	const std::string m_name;
+	std::atomic<std::uint64_t> m_acquisitions;
+	std::atomic<std::uint64_t> m_contended_acquisitions;
+	std::atomic<std::uint64_t> m_total_wait_ns;
+	std::atomic<std::uint64_t> m_max_wait_ns;
+	std::atomic<std::uint64_t> m_hold_time_histogram[LockStats::histogram_size];
+};
+
+} // namespace detail
+
+// The profiled locks that are alive, in the order in which they were created.
+class LockProfileRegistry
+{
+public:
+	static LockProfileRegistry& instance()
+	{
+		static LockProfileRegistry* registry = new LockProfileRegistry; // never destroyed, locks may outlive static destruction
+		return *registry;
+	}
+
+	std::vector<LockStats> get_stats() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		std::vector<LockStats> stats;
+		for (std::size_t i = 0U; i < m_profiles.size(); ++i)
+			stats.push_back(m_profiles[i]->get_stats());
+		return stats;
+	}
+
+	std::string to_text() const
+	{
+		const std::vector<LockStats> stats = get_stats();
+		std::string text;
+		for (std::size_t i = 0U; i < stats.size(); ++i)
+			text += stats[i].to_text();
+		return text;
+	}
+
+	std::string to_json() const
+	{
+		const std::vector<LockStats> stats = get_stats();
+		std::string json = "[";
+		for (std::size_t i = 0U; i < stats.size(); ++i) {
+			if (i > 0U)
+				json += ",";
+			json += stats[i].to_json();
+		}
+		json += "]";
+		return json;
+	}
+
+	void add(const detail::LockProfile* profile)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_profiles.push_back(profile);
+	}
+
+	void remove(const detail::LockProfile* profile)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (std::size_t i = 0U; i < m_profiles.size(); ++i) {
+			if (m_profiles[i] == profile) {
+				m_profiles.erase(m_profiles.begin() + static_cast<std::ptrdiff_t>(i));
+				break;
+			}
+		}
+	}
+
+private:
+	LockProfileRegistry()
+	{
+	}
+
+	mutable std::mutex m_mutex;
+	std::vector<const detail::LockProfile*> m_profiles;
+};
+
+#ifdef RES_MGR_LOCK_PROFILING
+template<class LockType>
+class ProfiledLock : public LockType
+{
+public:
+	explicit ProfiledLock(const char* name = NULL) : m_profile(name)
+	{
+		LockProfileRegistry::instance().add(&m_profile);
+	}
+
+	~ProfiledLock()
+	{
+		LockProfileRegistry::instance().remove(&m_profile);
+	}
+
+	void lock()
+	{
+		if (LockType::try_lock()) {
+			acquired(false, clock_type::time_point());
+		} else {
+			const clock_type::time_point start = clock_type::now();
+			LockType::lock();
+			acquired(true, start);
+		}
+	}
+
+	bool try_lock()
+	{
+		if (!LockType::try_lock())
+			return false;
+		acquired(false, clock_type::time_point());
+		return true;
+	}
+
+	template<class Rep, class Period>
+	bool try_lock_for(const std::chrono::duration<Rep, Period>& timeout)
+	{
+		if (LockType::try_lock()) {
+			acquired(false, clock_type::time_point());
+			return true;
+		}
+		const clock_type::time_point start = clock_type::now();
+		if (!LockType::try_lock_for(timeout))
+			return false;
+		acquired(true, start);
+		return true;
+	}
+
+	void unlock()
+	{
+		const std::chrono::nanoseconds held = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - m_acquired_at);
+		m_profile.record_hold(static_cast<std::uint64_t>(held.count()));
+		LockType::unlock();
+	}
+
+	LockStats get_stats() const
+	{
+		return m_profile.get_stats();
+	}
+
+private:
+	typedef std::chrono::steady_clock clock_type;
+
+	ProfiledLock(const ProfiledLock&);
+	ProfiledLock& operator=(const ProfiledLock&);
+
+	// Called with the lock held.
+	void acquired(bool contended, clock_type::time_point wait_start)
+	{
+		m_acquired_at = clock_type::now();
+		const std::uint64_t wait_ns = contended ?
+			static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(m_acquired_at - wait_start).count()) : 0U;
+		m_profile.record_acquisition(contended, wait_ns);
+	}
+
+	detail::LockProfile m_profile;
+	clock_type::time_point m_acquired_at;
+};
+#else
+template<class LockType>
+class ProfiledLock : public LockType
+{
+public:
+	explicit ProfiledLock(const char* = NULL)
+	{
+	}
+
+	LockStats get_stats() const
+	{
+		return LockStats();
+	}
+};
+#endif
+
+} // namespace
+
+#endif
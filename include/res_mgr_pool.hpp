@@ -0,0 +1,424 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2026 MH Lim
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// requires C++11
+
+#ifndef RESOURCE_MANAGER_POOL_HPP
+#define RESOURCE_MANAGER_POOL_HPP
+
+#include "res_mgr_config.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+
+#if defined _WIN32 || defined _WIN64
+#include <malloc.h>
+#endif
+
+namespace res_mgr {
+
+struct SlabPoolStats
+{
+	std::size_t block_size;      // size of a block in bytes
+	std::size_t blocks_per_slab; // number of blocks in a slab
+	std::size_t slab_count;      // number of slabs allocated so far, slabs are never returned to the system
+	std::size_t capacity;        // number of blocks in all slabs
+	std::size_t live_blocks;     // number of blocks allocated and not yet deallocated
+	double occupancy;            // live_blocks / capacity
+};
+
+/*
+A pool of fixed size blocks carved out of 64 KiB slabs.
+Every thread keeps a cache of free blocks, so allocation and deallocation normally do not touch any shared data.
+When a cache grows too large, a batch of blocks is pushed onto a global lock-free stack, which is where other threads refill from.
+A new slab is only allocated (under a mutex) when the global stack is empty.
+
+The global stack refers to a batch by the index of its first block and a tag that is incremented on every change,
+so that both fit into a single 64-bit word and the ABA problem is avoided without a double-width compare-and-swap.
+A block index is turned back into an address through a two-level table of slabs, whose chunks of slabs_per_chunk entries
+are allocated as the pool grows, so that an unused pool does not pay for the table of max_slab_count slabs.
+
+The pool of each block size is a singleton that is never destroyed,
+so blocks may be deallocated during the destruction of static objects and after the thread cache is gone.
+*/
+template<std::size_t minimum_block_size>
+class SlabPool
+{
+public:
+	static const std::size_t block_alignment = 16U;
+	static const std::size_t block_size = ((minimum_block_size < block_alignment ? block_alignment : minimum_block_size) + block_alignment - 1U)
+		/ block_alignment * block_alignment;
+	static const std::size_t slab_size = 65536U;
+	static const std::size_t slab_header_size = RES_MGR_CACHE_LINE_SIZE;
+	static const std::size_t blocks_per_slab = (slab_size - slab_header_size) / block_size;
+	static const std::size_t max_slab_count = 65536U;
+	static const std::size_t slabs_per_chunk = 256U;
+	static const std::size_t batch_size = 64U;
+
+	static SlabPool& instance()
+	{
+		static SlabPool* pool = new SlabPool; // never destroyed
+		return *pool;
+	}
+
+	// Throws std::bad_alloc on failure.
+	void* allocate()
+	{
+		ThreadCache* cache = get_thread_cache();
+		if (cache == NULL)
+			return allocate_without_cache();
+
+		if (cache->head == NULL)
+			refill(cache);
+
+		FreeBlock* block = cache->head;
+		cache->head = block->next;
+		--cache->count;
+		cache->allocations.store(cache->allocations.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+		return block;
+	}
+
+	void deallocate(void* p)
+	{
+		if (p == NULL)
+			return;
+
+		ThreadCache* cache = get_thread_cache();
+		if (cache == NULL) {
+			FreeBlock* block = static_cast<FreeBlock*>(p);
+			block->next = NULL;
+			block->batch_count = 1U;
+			push_batch(block);
+			m_retired_deallocations.fetch_add(1U, std::memory_order_relaxed);
+			return;
+		}
+
+		FreeBlock* block = static_cast<FreeBlock*>(p);
+		block->next = cache->head;
+		cache->head = block;
+		++cache->count;
+		cache->deallocations.store(cache->deallocations.load(std::memory_order_relaxed) + 1U, std::memory_order_relaxed);
+		if (cache->count >= 2U * batch_size)
+			flush(cache, batch_size);
+	}
+
+	SlabPoolStats get_stats()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		long long live = static_cast<long long>(m_retired_allocations.load(std::memory_order_relaxed))
+			- static_cast<long long>(m_retired_deallocations.load(std::memory_order_relaxed));
+		for (ThreadCache* cache = m_caches; cache != NULL; cache = cache->next_cache) {
+			live += static_cast<long long>(cache->allocations.load(std::memory_order_relaxed));
+			live -= static_cast<long long>(cache->deallocations.load(std::memory_order_relaxed));
+		}
+
+		SlabPoolStats stats;
+		stats.block_size = block_size;
+		stats.blocks_per_slab = blocks_per_slab;
+		stats.slab_count = m_slab_count.load(std::memory_order_relaxed);
+		stats.capacity = stats.slab_count * blocks_per_slab;
+		stats.live_blocks = (live > 0) ? static_cast<std::size_t>(live) : 0U;
+		stats.occupancy = (stats.capacity > 0U) ? (static_cast<double>(stats.live_blocks) / static_cast<double>(stats.capacity)) : 0.0;
+		return stats;
+	}
+
+private:
+	// The layout of a block while it is free.
+	struct FreeBlock
+	{
+		FreeBlock* next;          // next block in the same batch
+		std::uint32_t next_batch; // index + 1 of the first block of the next batch on the global stack, 0 for none
+		std::uint32_t batch_count;
+	};
+
+	struct SlabHeader
+	{
+		std::uint32_t id;
+	};
+
+	struct ThreadCache
+	{
+		FreeBlock* head;
+		std::size_t count;
+		// Only written by the owner thread, read by get_stats().
+		std::atomic<std::size_t> allocations;
+		std::atomic<std::size_t> deallocations;
+		ThreadCache* next_cache;
+	};
+
+	// Trivially destructible, so it can still be read after the thread cache has been retired.
+	struct ThreadState
+	{
+		ThreadCache* cache;
+		bool retired;
+	};
+
+	struct ThreadCacheGuard
+	{
+		~ThreadCacheGuard()
+		{
+			if (s_thread_state.cache != NULL)
+				SlabPool::instance().retire(s_thread_state.cache);
+			s_thread_state.cache = NULL;
+			s_thread_state.retired = true;
+		}
+	};
+
+	static_assert(sizeof(FreeBlock) <= block_size, "A block is too small to hold the free list links.");
+	static_assert(blocks_per_slab * max_slab_count <= 0xFFFFFFFFU, "Block indices do not fit into 32 bits.");
+	static_assert(max_slab_count % slabs_per_chunk == 0U, "The slab table is made of whole chunks.");
+
+	static const std::size_t slab_chunk_count = max_slab_count / slabs_per_chunk;
+
+	struct SlabChunk
+	{
+		std::atomic<unsigned char*> slabs[slabs_per_chunk];
+	};
+
+	SlabPool() : m_head(0U), m_slab_count(0U), m_caches(NULL), m_retired_allocations(0U), m_retired_deallocations(0U)
+	{
+		for (std::size_t i = 0U; i < slab_chunk_count; ++i)
+			m_slab_chunks[i].store(NULL, std::memory_order_relaxed);
+	}
+
+	ThreadCache* get_thread_cache()
+	{
+		ThreadState& state = s_thread_state;
+		if (state.cache == NULL && !state.retired) {
+			static thread_local ThreadCacheGuard guard;
+			(void) guard;
+			ThreadCache* cache = new ThreadCache;
+			cache->head = NULL;
+			cache->count = 0U;
+			cache->allocations.store(0U, std::memory_order_relaxed);
+			cache->deallocations.store(0U, std::memory_order_relaxed);
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				cache->next_cache = m_caches;
+				m_caches = cache;
+			}
+			state.cache = cache;
+		}
+		return state.cache;
+	}
+
+	// Called when a thread exits, returns the cached blocks to the global stack.
+	void retire(ThreadCache* cache)
+	{
+		while (cache->count > 0U)
+			flush(cache, batch_size);
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_retired_allocations.fetch_add(cache->allocations.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		m_retired_deallocations.fetch_add(cache->deallocations.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		for (ThreadCache** p = &m_caches; *p != NULL; p = &((*p)->next_cache)) {
+			if (*p == cache) {
+				*p = cache->next_cache;
+				break;
+			}
+		}
+		delete cache;
+	}
+
+	void* allocate_without_cache()
+	{
+		FreeBlock* batch = pop_batch();
+		if (batch == NULL)
+			batch = allocate_slab();
+
+		FreeBlock* rest = batch->next;
+		if (rest != NULL) {
+			rest->batch_count = batch->batch_count - 1U;
+			push_batch(rest);
+		}
+		m_retired_allocations.fetch_add(1U, std::memory_order_relaxed);
+		return batch;
+	}
+
+	void refill(ThreadCache* cache)
+	{
+		FreeBlock* batch = pop_batch();
+		if (batch == NULL)
+			batch = allocate_slab();
+		cache->head = batch;
+		cache->count = batch->batch_count;
+	}
+
+	// Moves up to the given number of blocks from the thread cache to the global stack.
+	void flush(ThreadCache* cache, std::size_t count)
+	{
+		FreeBlock* first = cache->head;
+		FreeBlock* last = first;
+		std::uint32_t n = 1U;
+		while (n < count && last->next != NULL) {
+			last = last->next;
+			++n;
+		}
+		cache->head = last->next;
+		cache->count -= n;
+		last->next = NULL;
+		first->batch_count = n;
+		push_batch(first);
+	}
+
+	std::uint32_t index_of(FreeBlock* block) const
+	{
+		const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(block);
+		const SlabHeader* slab = reinterpret_cast<const SlabHeader*>(address & ~static_cast<std::uintptr_t>(slab_size - 1U));
+		const std::size_t offset = address - reinterpret_cast<std::uintptr_t>(slab) - slab_header_size;
+		return static_cast<std::uint32_t>(slab->id * blocks_per_slab + offset / block_size);
+	}
+
+	FreeBlock* block_at(std::uint32_t index) const
+	{
+		const std::size_t id = index / blocks_per_slab;
+		const SlabChunk* chunk = m_slab_chunks[id / slabs_per_chunk].load(std::memory_order_acquire);
+		unsigned char* slab = chunk->slabs[id % slabs_per_chunk].load(std::memory_order_acquire);
+		return reinterpret_cast<FreeBlock*>(slab + slab_header_size + (index % blocks_per_slab) * block_size);
+	}
+
+	void push_batch(FreeBlock* batch)
+	{
+		const std::uint64_t index = static_cast<std::uint64_t>(index_of(batch)) + 1U;
+		std::uint64_t old_head = m_head.load(std::memory_order_relaxed);
+		std::uint64_t new_head;
+		do {
+			batch->next_batch = static_cast<std::uint32_t>(old_head);
+			new_head = (((old_head >> 32) + 1U) << 32) | index;
+		} while (!m_head.compare_exchange_weak(old_head, new_head, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	FreeBlock* pop_batch()
+	{
+		std::uint64_t old_head = m_head.load(std::memory_order_acquire);
+		while (static_cast<std::uint32_t>(old_head) != 0U) {
+			FreeBlock* batch = block_at(static_cast<std::uint32_t>(old_head) - 1U);
+			// The batch may be popped and reused by another thread at the same time,
+			// next_batch is then stale, but the tag makes the compare-and-swap fail.
+			const std::uint64_t new_head = (((old_head >> 32) + 1U) << 32) | batch->next_batch;
+			if (m_head.compare_exchange_weak(old_head, new_head, std::memory_order_acquire, std::memory_order_acquire))
+				return batch;
+		}
+		return NULL;
+	}
+
+	// Allocates a new slab and returns all its blocks as a batch, throws std::bad_alloc on failure.
+	FreeBlock* allocate_slab()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		const std::size_t id = m_slab_count.load(std::memory_order_relaxed);
+		if (id >= max_slab_count)
+			throw std::bad_alloc();
+
+		// The chunk of the table is allocated with its first slab, it is kept if the slab cannot be allocated.
+		SlabChunk* chunk = m_slab_chunks[id / slabs_per_chunk].load(std::memory_order_relaxed);
+		if (chunk == NULL) {
+			chunk = new SlabChunk;
+			for (std::size_t i = 0U; i < slabs_per_chunk; ++i)
+				chunk->slabs[i].store(NULL, std::memory_order_relaxed);
+			m_slab_chunks[id / slabs_per_chunk].store(chunk, std::memory_order_release);
+		}
+
+		unsigned char* slab = static_cast<unsigned char*>(allocate_aligned(slab_size));
+		if (slab == NULL)
+			throw std::bad_alloc();
+
+		reinterpret_cast<SlabHeader*>(slab)->id = static_cast<std::uint32_t>(id);
+		FreeBlock* first = reinterpret_cast<FreeBlock*>(slab + slab_header_size);
+		FreeBlock* block = first;
+		for (std::size_t i = 1U; i < blocks_per_slab; ++i) {
+			FreeBlock* next = reinterpret_cast<FreeBlock*>(slab + slab_header_size + i * block_size);
+			block->next = next;
+			block = next;
+		}
+		block->next = NULL;
+		first->batch_count = static_cast<std::uint32_t>(blocks_per_slab);
+
+		chunk->slabs[id % slabs_per_chunk].store(slab, std::memory_order_release);
+		m_slab_count.store(id + 1U, std::memory_order_relaxed);
+		return first;
+	}
+
+	static void* allocate_aligned(std::size_t number_of_bytes)
+	{
+#if defined _WIN32 || defined _WIN64
+		return _aligned_malloc(number_of_bytes, number_of_bytes);
+#else
+		void* p = NULL;
+		return (posix_memalign(&p, number_of_bytes, number_of_bytes) == 0) ? p : NULL;
+#endif
+	}
+
+	std::atomic<std::uint64_t> m_head; // tag in the upper 32 bits, index + 1 of the first block of the top batch in the lower 32 bits
+	std::atomic<std::size_t> m_slab_count;
+	std::atomic<SlabChunk*> m_slab_chunks[slab_chunk_count]; // chunks of the slab table, never freed as the pool is never destroyed
+	std::mutex m_mutex; // protects the slab allocation and the list of thread caches
+	ThreadCache* m_caches;
+	std::atomic<std::size_t> m_retired_allocations;
+	std::atomic<std::size_t> m_retired_deallocations;
+
+	static thread_local ThreadState s_thread_state;
+};
+
+template<std::size_t minimum_block_size>
+thread_local typename SlabPool<minimum_block_size>::ThreadState SlabPool<minimum_block_size>::s_thread_state = { NULL, false };
+
+/*
+A reference count allocator for SharedResource (see RefCountAllocator in res_mgr_shared.hpp) which takes the
+reference count variables from a SlabPool instead of the global operator new.
+e.g. SharedResource<int, -1, SocketFunctor, long, std::atomic<long>, SlabRefCountAllocator<std::atomic<long> > >
+*/
+template<typename RefCountAtomicType>
+struct SlabRefCountAllocator
+{
+	typedef SlabPool<sizeof(RefCountAtomicType)> pool_type;
+
+	static_assert(alignof(RefCountAtomicType) <= pool_type::block_alignment, "The reference count type needs a larger alignment.");
+
+	template<typename ResourceType>
+	static RefCountAtomicType* allocate(ResourceType)
+	{
+		return new (pool_type::instance().allocate()) RefCountAtomicType;
+	}
+
+	static void deallocate(RefCountAtomicType* p_refcount)
+	{
+		p_refcount->~RefCountAtomicType();
+		pool_type::instance().deallocate(p_refcount);
+	}
+
+	static SlabPoolStats get_stats()
+	{
+		return pool_type::instance().get_stats();
+	}
+};
+
+} // namespace
+
+#endif
@@ -0,0 +1,288 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2026 MH Lim
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// requires C++11
+
+#ifndef RESOURCE_MANAGER_RECLAIM_HPP
+#define RESOURCE_MANAGER_RECLAIM_HPP
+
+#include "res_mgr_config.hpp"
+#include "res_mgr_pool.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <thread>
+
+namespace res_mgr {
+
+struct ReclaimerStats
+{
+	std::size_t queue_depth;   // number of resources waiting to be released
+	std::size_t queued;        // number of resources queued so far
+	std::size_t reclaimed;     // number of resources released so far
+	std::size_t batches;       // number of batches released so far
+	double average_latency_ns; // average time between queuing and releasing a resource
+	double max_latency_ns;     // longest time between queuing and releasing a resource
+};
+
+/*
+Releases resources on a background thread instead of the thread that drops the last reference.
+Resources are queued on a lock-free multiple-producer single-consumer queue and released in batches by the reclaimer thread,
+which wakes up when a batch is full, when flush() is called or after the given interval.
+The nodes of the queue come from a SlabPool, so queuing a resource does not call the global operator new.
+Template parameters:
+1) ResourceType: the type of the resource being managed
+2) ResourceFunctor: the functor that releases the resource (see Resource)
+
+A reclaimer is used through DeferredFunctor, see below.
+*/
+template<typename ResourceType, class ResourceFunctor>
+class DeferredReclaimer
+{
+public:
+	explicit DeferredReclaimer(std::size_t batch_size = 64U, std::chrono::milliseconds interval = std::chrono::milliseconds(10),
+		const ResourceFunctor& functor = ResourceFunctor()) :
+		m_functor(functor), m_batch_size((batch_size > 0U) ? batch_size : 1U), m_interval(interval),
+		m_head(&m_stub), m_tail(&m_stub), m_queued(0U), m_reclaimed(0U), m_batches(0U),
+		m_total_latency_ns(0.0), m_max_latency_ns(0.0), m_stop(false), m_wake_up(false)
+	{
+		m_stub.next.store(NULL, std::memory_order_relaxed);
+		m_thread = std::thread(&DeferredReclaimer::run, this);
+	}
+
+	// Stops the reclaimer thread and releases the resources that are still queued.
+	~DeferredReclaimer()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_condition.notify_one();
+		m_thread.join();
+		drain();
+		if (m_tail != &m_stub) {
+			m_tail->~Node();
+			node_pool::instance().deallocate(m_tail);
+		}
+	}
+
+	// Queues a resource, called by any thread.
+	// Returns false without queuing the resource if no node can be allocated, the caller then has to release the resource itself.
+	bool push(ResourceType resource) RES_MGR_NOEXCEPT
+	{
+		void* memory = NULL;
+		try {
+			memory = node_pool::instance().allocate();
+		} catch (const std::bad_alloc&) {
+			return false;
+		}
+
+		Node* node = new (memory) Node;
+		node->resource = resource;
+		node->queued_at = clock_type::now();
+		node->next.store(NULL, std::memory_order_relaxed);
+		Node* previous = m_head.exchange(node, std::memory_order_acq_rel);
+		previous->next.store(node, std::memory_order_release);
+
+		const std::size_t queued = m_queued.fetch_add(1U, std::memory_order_relaxed) + 1U;
+		if (queued % m_batch_size == 0U)
+			flush();
+		return true;
+	}
+
+	// Wakes up the reclaimer thread without waiting for it.
+	// The mutex is not taken, so that push() cannot throw. A notification that arrives while the reclaimer thread
+	// is about to wait is lost, the batch is then released after the interval.
+	void flush() RES_MGR_NOEXCEPT
+	{
+		m_wake_up.store(true, std::memory_order_release);
+		m_condition.notify_one();
+	}
+
+	// Releases all queued resources on the calling thread and returns their number.
+	std::size_t drain()
+	{
+		std::lock_guard<std::mutex> lock(m_consumer_mutex);
+		std::size_t count = 0U;
+		std::size_t released;
+		while ((released = release_batch()) > 0U)
+			count += released;
+		return count;
+	}
+
+	ReclaimerStats get_stats() const
+	{
+		std::lock_guard<std::mutex> lock(m_consumer_mutex);
+		ReclaimerStats stats;
+		stats.queued = m_queued.load(std::memory_order_relaxed);
+		stats.reclaimed = m_reclaimed;
+		stats.queue_depth = (stats.queued > stats.reclaimed) ? (stats.queued - stats.reclaimed) : 0U;
+		stats.batches = m_batches;
+		stats.average_latency_ns = (m_reclaimed > 0U) ? (m_total_latency_ns / static_cast<double>(m_reclaimed)) : 0.0;
+		stats.max_latency_ns = m_max_latency_ns;
+		return stats;
+	}
+
+private:
+	typedef std::chrono::steady_clock clock_type;
+
+	struct Node
+	{
+		std::atomic<Node*> next;
+		ResourceType resource;
+		clock_type::time_point queued_at;
+	};
+
+	typedef SlabPool<sizeof(Node)> node_pool;
+
+	DeferredReclaimer(const DeferredReclaimer&);
+	DeferredReclaimer& operator=(const DeferredReclaimer&);
+
+	void run()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		while (!m_stop) {
+			m_condition.wait_for(lock, m_interval, [this]() { return m_stop || m_wake_up.load(std::memory_order_acquire); });
+			m_wake_up.store(false, std::memory_order_relaxed);
+			lock.unlock();
+			drain();
+			lock.lock();
+		}
+	}
+
+	// Releases up to one batch of resources, called with m_consumer_mutex held.
+	std::size_t release_batch()
+	{
+		std::size_t count = 0U;
+		while (count < m_batch_size) {
+			Node* tail = m_tail;
+			Node* next = tail->next.load(std::memory_order_acquire);
+			if (next == NULL)
+				break; // empty, or a producer has not linked its node yet
+
+			// The clock is read per node, a node may have been queued after the batch started.
+			const ResourceType resource = next->resource;
+			const double latency = std::chrono::duration<double, std::nano>(clock_type::now() - next->queued_at).count();
+			m_tail = next;
+			if (tail != &m_stub) {
+				tail->~Node();
+				node_pool::instance().deallocate(tail);
+			}
+
+			m_functor(resource);
+			m_total_latency_ns += latency;
+			if (latency > m_max_latency_ns)
+				m_max_latency_ns = latency;
+			++count;
+		}
+
+		if (count > 0U) {
+			m_reclaimed += count;
+			++m_batches;
+		}
+		return count;
+	}
+
+	ResourceFunctor m_functor; // only used by the thread that holds m_consumer_mutex
+	const std::size_t m_batch_size;
+	const std::chrono::milliseconds m_interval;
+
+	// The queue always keeps its last node, the stub node is used while no node has been queued.
+	Node m_stub;
+	std::atomic<Node*> m_head;     // last node, exchanged by the producers
+	Node* m_tail;                  // node before the first queued resource, only used by the consumer
+	std::atomic<std::size_t> m_queued;
+
+	// The following members are protected by m_consumer_mutex.
+	mutable std::mutex m_consumer_mutex;
+	std::size_t m_reclaimed;
+	std::size_t m_batches;
+	double m_total_latency_ns;
+	double m_max_latency_ns;
+
+	// m_stop is protected by m_mutex, m_wake_up is set by flush() without it.
+	std::mutex m_mutex;
+	std::condition_variable m_condition;
+	bool m_stop;
+	std::atomic<bool> m_wake_up;
+
+	std::thread m_thread;
+};
+
+/*
+A functor which queues the resource on a DeferredReclaimer instead of releasing it.
+It can be used as the ResourceFunctor of Resource, SharedResource or IntrusiveSharedResource.
+It keeps its own ResourceFunctor, which checks the validity of resources and releases them immediately
+if the functor was constructed without a reclaimer or if the reclaimer cannot queue them.
+The functor of the reclaimer is only used by the reclaimer, so the two are never called at the same time.
+The reclaimer must outlive the resources that refer to it.
+
+e.g.
+typedef res_mgr::DeferredReclaimer<int, SocketFunctor> SocketReclaimer;
+typedef res_mgr::DeferredFunctor<int, SocketFunctor> DeferredSocketFunctor;
+typedef res_mgr::SharedResource<int, -1, DeferredSocketFunctor, long, std::atomic<long> > SharedSocket;
+
+SocketReclaimer reclaimer(128);
+SharedSocket socket(::socket(AF_INET, SOCK_STREAM, 0), DeferredSocketFunctor(&reclaimer));
+*/
+template<typename ResourceType, class ResourceFunctor>
+class DeferredFunctor
+{
+public:
+	typedef DeferredReclaimer<ResourceType, ResourceFunctor> reclaimer_type;
+
+	explicit DeferredFunctor(reclaimer_type* reclaimer = NULL, const ResourceFunctor& functor = ResourceFunctor()) :
+		m_reclaimer(reclaimer), m_functor(functor)
+	{
+	}
+
+	void operator()(ResourceType resource)
+	{
+		if (m_reclaimer == NULL || !m_reclaimer->push(resource))
+			m_functor(resource);
+	}
+
+	bool operator()(ResourceType resource, ResourceType invalid_value)
+	{
+		return m_functor(resource, invalid_value);
+	}
+
+	reclaimer_type* get_reclaimer() const
+	{
+		return m_reclaimer;
+	}
+
+private:
+	reclaimer_type* m_reclaimer;
+	ResourceFunctor m_functor;
+};
+
+} // namespace
+
+#endif
@@ -27,10 +27,81 @@ SOFTWARE.
 #ifndef RESOURCE_MANAGER_RESOURCE_HPP
 #define RESOURCE_MANAGER_RESOURCE_HPP
 
+#include "res_mgr_config.hpp"
+
+#ifdef RES_MGR_HAS_CXX11
+#include <type_traits>
+#include <utility>
+#endif
+
 namespace res_mgr {
+
+namespace detail {
+
+#ifdef RES_MGR_HAS_CXX11
+// Resource objects can only be moved without throwing if their functor can.
+template<class ResourceFunctor>
+struct is_nothrow_movable
+{
+	static const bool value = std::is_nothrow_move_constructible<ResourceFunctor>::value && std::is_nothrow_move_assignable<ResourceFunctor>::value;
+};
+#endif
+
+// Stores a resource together with its functor.
+// The functor is a base class, so an empty functor does not take any space (empty base optimization).
+template<typename ResourceType, class ResourceFunctor>
+class ResourceStorage : public ResourceFunctor
+{
+public:
+	ResourceStorage(ResourceType resource, const ResourceFunctor& functor) : ResourceFunctor(functor), m_resource(resource)
+	{
+	}
+
+#ifdef RES_MGR_HAS_CXX11
+	ResourceStorage(ResourceType resource, ResourceFunctor&& functor) : ResourceFunctor(std::move(functor)), m_resource(resource)
+	{
+	}
+#endif
+
+	ResourceFunctor& functor()
+	{
+		return *this;
+	}
+
+	// The functor is called from const member functions such as is_valid(), its operator() need not be const.
+	ResourceFunctor& functor() const
+	{
+		return const_cast<ResourceStorage&>(*this);
+	}
+
+#ifdef RES_MGR_HAS_CXX11
+	void swap_functor(ResourceStorage& src) noexcept(is_nothrow_movable<ResourceFunctor>::value)
+	{
+		ResourceFunctor functor_ = std::move(functor());
+		functor() = std::move(src.functor());
+		src.functor() = std::move(functor_);
+	}
+#else
+	void swap_functor(ResourceStorage& src)
+	{
+		ResourceFunctor functor_ = functor();
+		functor() = src.functor();
+		src.functor() = functor_;
+	}
+#endif
+
+	ResourceType m_resource;
+};
+
+} // namespace
+
 /*
  Only one copy of resource is allowed.
- Copying the resource from a non-const resource object to another will transfer the ownership.
+ With C++11 or later, the ownership is transferred by moving the resource object, copying is not allowed.
+ Before C++11, copying the resource from a non-const resource object to another will transfer the ownership.
+ A resource object only holds the raw resource and its functor, moving it copies both and resets the source to invalid_value.
+ Therefore containers such as std::vector can relocate resource objects without any allocation per element.
+ Moving and swapping are noexcept as long as moving the functor cannot throw.
  Template parameters:
  1) ResourceType: the type of the resource being managed, e.g. a socket descriptor or a file handle.
  2) invalid_value: a value that represents an invalid resource or no resource.
@@ -38,6 +109,11 @@ namespace res_mgr {
     - void operator() (ResourceType resource): a function to release the resource
     - bool operator() (ResourceType resource, ResourceType invalid_value): a function to compare the resource to an invalid value
 
+ The functor is stored in the resource object.
+ A functor without non-static data members does not take any space, so the resource object is as large as the raw resource.
+ A functor may also have non-static data members, e.g. a pointer to the pool that the resource is returned to.
+ Such a functor is passed to the constructor and moved together with the resource.
+
  e.g.
  class SocketFunctor {
  public:
@@ -48,7 +124,6 @@ namespace res_mgr {
 	      return (resource_value <= invalid_value);
  	 }
 	 // optional: static member functions
-	 // no other non-static members
 }
 */
 
@@ -56,7 +131,7 @@ template <typename ResourceType, ResourceType invalid_value, class ResourceFunct
 class Resource
 {
 public:
-	Resource(ResourceType resource = invalid_value) : m_resource(resource)
+	Resource(ResourceType resource = invalid_value, const ResourceFunctor& functor = ResourceFunctor()) : m_storage(resource, functor)
 	{
 	}
 
@@ -65,26 +140,49 @@ public:
 		release();
 	}
 
-	Resource(Resource& src) : m_resource(src.m_resource)
+#ifdef RES_MGR_HAS_CXX11
+	Resource(Resource&& src) noexcept(detail::is_nothrow_movable<ResourceFunctor>::value) :
+		m_storage(src.m_storage.m_resource, std::move(src.m_storage.functor()))
 	{
-		src.m_resource = invalid_value;
+		src.m_storage.m_resource = invalid_value;
+	}
+
+	Resource& operator=(Resource&& src) noexcept(detail::is_nothrow_movable<ResourceFunctor>::value)
+	{
+		if (this != &src) {
+			release();
+			m_storage.m_resource = src.m_storage.m_resource;
+			m_storage.functor() = std::move(src.m_storage.functor());
+			src.m_storage.m_resource = invalid_value;
+		}
+		return *this;
+	}
+
+	Resource(const Resource&) = delete;
+	Resource& operator=(const Resource&) = delete;
+#else
+	Resource(Resource& src) : m_storage(src.m_storage.m_resource, src.m_storage.functor())
+	{
+		src.m_storage.m_resource = invalid_value;
 	}
 
 	Resource& operator=(Resource& src)
 	{
 		if (this != &src) {
 			release();
-			m_resource = src.m_resource;
-			src.m_resource = invalid_value;
+			m_storage.m_resource = src.m_storage.m_resource;
+			m_storage.functor() = src.m_storage.functor();
+			src.m_storage.m_resource = invalid_value;
 		}
 		return *this;
 	}
+#endif
 
 	Resource& operator=(ResourceType resource)
 	{
-		if (m_resource != resource) {
+		if (m_storage.m_resource != resource) {
 			release();
-			m_resource = resource;
+			m_storage.m_resource = resource;
 		}
 		return *this;
 	}
@@ -93,36 +191,56 @@ public:
 	{
 		if (is_valid())
 		{
-			ResourceFunctor release_;
-			release_(m_resource);
-			m_resource = invalid_value;
+			m_storage.functor()(m_storage.m_resource);
+			m_storage.m_resource = invalid_value;
 		}
 	}
 
+	// Gives up the ownership without releasing the resource, the caller becomes responsible for releasing the returned resource.
+	ResourceType detach() RES_MGR_NOEXCEPT
+	{
+		const ResourceType resource = m_storage.m_resource;
+		m_storage.m_resource = invalid_value;
+		return resource;
+	}
+
 	ResourceType get() const
 	{
-		return m_resource;
+		return m_storage.m_resource;
+	}
+
+	ResourceFunctor& get_functor()
+	{
+		return m_storage.functor();
+	}
+
+	const ResourceFunctor& get_functor() const
+	{
+		return m_storage.functor();
 	}
 
 	bool is_valid() const
 	{
-		ResourceFunctor compare;
-		return compare(m_resource, invalid_value);
+		return m_storage.functor()(m_storage.m_resource, invalid_value);
 	}
 
-	void swap(Resource& src)
+	// Does not throw unless moving (before C++11: copying) the functor throws.
+	void swap(Resource& src) RES_MGR_NOEXCEPT_IF(detail::is_nothrow_movable<ResourceFunctor>::value)
 	{
 		if (this != &src) {
-			ResourceType resource = m_resource;
-			m_resource = src.m_resource;
-			src.m_resource = resource;
+			ResourceType resource = m_storage.m_resource;
+			m_storage.m_resource = src.m_storage.m_resource;
+			src.m_storage.m_resource = resource;
+			m_storage.swap_functor(src.m_storage);
 		}
 	}
 
 private:
+#ifndef RES_MGR_HAS_CXX11
 	Resource(const Resource&);            // disallows constructing from const resource objects
 	Resource& operator=(const Resource&); // disallows copying from const resource objects
-	ResourceType m_resource;
+#endif
+	detail::ResourceStorage<ResourceType, ResourceFunctor> m_storage;
 };
 
 } // namespace
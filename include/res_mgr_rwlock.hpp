@@ -0,0 +1,129 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2026 MH Lim
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// requires C++11
+
+#ifndef RESOURCE_MANAGER_RWLOCK_HPP
+#define RESOURCE_MANAGER_RWLOCK_HPP
+
+#include "res_mgr_config.hpp"
+#include "res_mgr_counter.hpp"
+#include "res_mgr_lock.hpp"
+#include "res_mgr_spinlock.hpp"
+#include <atomic>
+#include <cstddef>
+
+namespace res_mgr {
+
+/*
+The state of a reader-biased reader-writer lock.
+A reader announces itself by incrementing one of several reader indicators, each on its own cache line,
+so readers running on different processors do not write to the same cache line.
+A writer sets the writer flag, which makes new readers wait, and waits until every indicator drops to 0.
+Every thread uses the same indicator for all locks, threads are assigned to the indicators in turn,
+so as long as there are no more threads than indicators, no two readers share an indicator.
+A lock takes slot_count cache lines, so it suits a few locks protecting data that is read far more often than it is written.
+*/
+struct ReaderBiasedLockState
+{
+	static const std::size_t slot_count = 64U;
+
+	struct Slot
+	{
+		std::atomic<long> readers;
+		char padding[RES_MGR_CACHE_LINE_SIZE - sizeof(std::atomic<long>)];
+	};
+
+	std::atomic<bool> writer;
+	char padding[RES_MGR_CACHE_LINE_SIZE - sizeof(std::atomic<bool>)];
+	Slot slots[slot_count];
+};
+
+struct ReaderBiasedLockInitFunctor {
+	void operator()(ReaderBiasedLockState& lock) {
+		lock.writer.store(false, std::memory_order_relaxed);
+		for (std::size_t i = 0U; i < ReaderBiasedLockState::slot_count; ++i)
+			lock.slots[i].readers.store(0, std::memory_order_relaxed);
+	}
+};
+
+struct ReaderBiasedLockDeinitFunctor {
+	void operator()(ReaderBiasedLockState&) {
+	}
+};
+
+struct ReaderBiasedLockLockFunctor {
+	void operator()(ReaderBiasedLockState& lock) {
+		detail::Backoff backoff;
+		while (lock.writer.load(std::memory_order_relaxed) || lock.writer.exchange(true, std::memory_order_seq_cst))
+			backoff.pause();
+
+		// The writer flag is set before the indicators are read (both sequentially consistent),
+		// so a reader either sees the flag or is seen by the writer.
+		for (std::size_t i = 0U; i < ReaderBiasedLockState::slot_count; ++i) {
+			detail::Backoff reader_backoff;
+			while (lock.slots[i].readers.load(std::memory_order_seq_cst) != 0)
+				reader_backoff.pause();
+		}
+	}
+};
+
+struct ReaderBiasedLockUnlockFunctor {
+	void operator()(ReaderBiasedLockState& lock) {
+		lock.writer.store(false, std::memory_order_release);
+	}
+};
+
+struct ReaderBiasedLockLockSharedFunctor {
+	void operator()(ReaderBiasedLockState& lock) {
+		std::atomic<long>& readers = lock.slots[detail::thread_index() % ReaderBiasedLockState::slot_count].readers;
+		for (;;) {
+			readers.fetch_add(1, std::memory_order_seq_cst);
+			if (!lock.writer.load(std::memory_order_seq_cst))
+				return;
+
+			// A writer holds the lock or waits for the readers, withdraw and wait until it is done.
+			readers.fetch_sub(1, std::memory_order_release);
+			detail::Backoff backoff;
+			while (lock.writer.load(std::memory_order_acquire))
+				backoff.pause();
+		}
+	}
+};
+
+struct ReaderBiasedLockUnlockSharedFunctor {
+	void operator()(ReaderBiasedLockState& lock) {
+		lock.slots[detail::thread_index() % ReaderBiasedLockState::slot_count].readers.fetch_sub(1, std::memory_order_release);
+	}
+};
+
+typedef ResourceSharedLock<ReaderBiasedLockState, ReaderBiasedLockInitFunctor, ReaderBiasedLockDeinitFunctor,
+	ReaderBiasedLockLockFunctor, ReaderBiasedLockUnlockFunctor,
+	ReaderBiasedLockLockSharedFunctor, ReaderBiasedLockUnlockSharedFunctor> ReaderBiasedLock;
+
+} // namespace
+
+#endif
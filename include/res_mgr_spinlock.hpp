@@ -0,0 +1,339 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2026 MH Lim
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// requires C++11
+
+#ifndef RESOURCE_MANAGER_SPINLOCK_HPP
+#define RESOURCE_MANAGER_SPINLOCK_HPP
+
+#include "res_mgr_config.hpp"
+#include "res_mgr_lock.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#if defined _MSC_VER && (defined _M_IX86 || defined _M_X64)
+#include <intrin.h>
+#endif
+
+#ifdef __linux__
+#include <ctime>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/*
+Functor sets for ResourceLock (see res_mgr_lock.hpp) implementing locks for short critical sections,
+which do not enter the kernel as long as the lock is released quickly.
+	- SpinLock: a test and test-and-set lock with exponential backoff
+	- TicketLock: a fair lock, the threads acquire it in the order in which they started to wait.
+	  Every hand-over waits for the next thread in line to run, so it is slow when there are more threads than processors.
+	- AdaptiveLock: spins for a bounded number of attempts, then sleeps on a futex (Linux) or yields (other platforms)
+A spinning thread yields its time slice after a while, so that it does not keep the holder of the lock from running
+when there are more threads than processors.
+All of them support try_lock() and try_lock_for() of ResourceLock.
+
+e.g.
+struct Counter {
+	res_mgr::SpinLock lock;
+	unsigned long value;
+};
+
+res_mgr::ResourceLockMechanism<res_mgr::SpinLock> lock(counter.lock);
+++counter.value;
+*/
+namespace res_mgr {
+
+namespace detail {
+
+// Tells the processor that the thread is spinning, which saves power and frees resources for the other hardware thread.
+inline void cpu_relax()
+{
+#if defined _MSC_VER && (defined _M_IX86 || defined _M_X64)
+	_mm_pause();
+#elif (defined __GNUC__ || defined __clang__) && (defined __i386__ || defined __x86_64__)
+	__builtin_ia32_pause();
+#elif (defined __GNUC__ || defined __clang__) && (defined __aarch64__ || defined __arm__)
+	asm volatile("yield" ::: "memory");
+#endif
+}
+
+inline unsigned int processor_count()
+{
+	static const unsigned int count = std::thread::hardware_concurrency();
+	return (count > 0U) ? count : 1U;
+}
+
+// Exponential backoff, the number of pauses doubles after every failed attempt up to a limit.
+class Backoff
+{
+public:
+	Backoff() : m_pauses(1U)
+	{
+	}
+
+	void pause()
+	{
+		if (m_pauses <= max_pauses) {
+			for (unsigned int i = 0U; i < m_pauses; ++i)
+				cpu_relax();
+			m_pauses <<= 1;
+		} else {
+			std::this_thread::yield();
+		}
+	}
+
+private:
+	static const unsigned int max_pauses = 1024U;
+	unsigned int m_pauses;
+};
+
+// Calls try_once until it succeeds or the timeout expires, backing off between two attempts.
+template<class TryFunction>
+bool try_for(unsigned long timeout_ms, TryFunction try_once)
+{
+	if (try_once())
+		return true;
+	if (timeout_ms == 0UL)
+		return false;
+
+	const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+	Backoff backoff;
+	do {
+		backoff.pause();
+		if (try_once())
+			return true;
+	} while (std::chrono::steady_clock::now() < deadline);
+	return false;
+}
+
+} // namespace detail
+
+// Test and test-and-set spinlock
+struct SpinLockInitFunctor {
+	void operator()(std::atomic<bool>& lock) {
+		lock.store(false, std::memory_order_relaxed);
+	}
+};
+
+struct SpinLockDeinitFunctor {
+	void operator()(std::atomic<bool>&) {
+	}
+};
+
+struct SpinLockLockFunctor {
+	void operator()(std::atomic<bool>& lock) {
+		detail::Backoff backoff;
+		// The lock is only written when it looks free, the waiting threads read their cached copy.
+		while (lock.load(std::memory_order_relaxed) || lock.exchange(true, std::memory_order_acquire))
+			backoff.pause();
+	}
+
+	bool operator()(std::atomic<bool>& lock, unsigned long timeout_ms) {
+		return detail::try_for(timeout_ms, [&lock]() {
+			return !lock.load(std::memory_order_relaxed) && !lock.exchange(true, std::memory_order_acquire);
+		});
+	}
+};
+
+struct SpinLockUnlockFunctor {
+	void operator()(std::atomic<bool>& lock) {
+		lock.store(false, std::memory_order_release);
+	}
+};
+
+typedef ResourceLock<std::atomic<bool>, SpinLockInitFunctor, SpinLockDeinitFunctor, SpinLockLockFunctor, SpinLockUnlockFunctor> SpinLock;
+
+// Ticket lock
+struct TicketLockState {
+	std::atomic<unsigned int> next;    // ticket of the next thread that starts waiting
+	std::atomic<unsigned int> serving; // ticket of the thread holding the lock
+};
+
+struct TicketLockInitFunctor {
+	void operator()(TicketLockState& lock) {
+		lock.next.store(0U, std::memory_order_relaxed);
+		lock.serving.store(0U, std::memory_order_relaxed);
+	}
+};
+
+struct TicketLockDeinitFunctor {
+	void operator()(TicketLockState&) {
+	}
+};
+
+struct TicketLockLockFunctor {
+	void operator()(TicketLockState& lock) {
+		const unsigned int ticket = lock.next.fetch_add(1U, std::memory_order_relaxed);
+		unsigned int serving;
+		unsigned int spins = 0U;
+		while ((serving = lock.serving.load(std::memory_order_acquire)) != ticket) {
+			// Proportional backoff, a thread further back in the queue waits longer between two reads.
+			// If more threads are ahead than there are processors, some of them are not running, so the thread yields.
+			const unsigned int waiting = ticket - serving;
+			if (waiting < detail::processor_count() && spins < 1024U) {
+				for (unsigned int i = 0U; i < waiting * 16U; ++i)
+					detail::cpu_relax();
+				++spins;
+			} else {
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	// Takes a ticket only if it is served at once, a thread cannot leave the queue once it has taken a ticket.
+	bool operator()(TicketLockState& lock, unsigned long timeout_ms) {
+		return detail::try_for(timeout_ms, [&lock]() {
+			unsigned int ticket = lock.serving.load(std::memory_order_acquire);
+			return lock.next.compare_exchange_strong(ticket, ticket + 1U, std::memory_order_acquire, std::memory_order_relaxed);
+		});
+	}
+};
+
+struct TicketLockUnlockFunctor {
+	void operator()(TicketLockState& lock) {
+		// Only the holder writes serving, so a load and a store are enough.
+		lock.serving.store(lock.serving.load(std::memory_order_relaxed) + 1U, std::memory_order_release);
+	}
+};
+
+typedef ResourceLock<TicketLockState, TicketLockInitFunctor, TicketLockDeinitFunctor, TicketLockLockFunctor, TicketLockUnlockFunctor> TicketLock;
+
+/*
+Adaptive lock
+The state is 0 if the lock is free, 1 if it is held and 2 if it is held and a thread may be sleeping on it.
+A thread spins for a bounded number of attempts before it sets the state to 2 and sleeps,
+the unlocking thread wakes up one sleeping thread only if the state was 2, so an uncontended unlock does not enter the kernel.
+*/
+namespace detail {
+
+static const unsigned int adaptive_lock_spins = 100U;
+
+inline void futex_wait(std::atomic<int>& state, int expected)
+{
+#ifdef __linux__
+	static_assert(sizeof(std::atomic<int>) == sizeof(int), "The futex word must be a plain int.");
+	syscall(SYS_futex, reinterpret_cast<int*>(&state), FUTEX_WAIT_PRIVATE, expected, NULL, NULL, 0);
+#else
+	(void)state;
+	(void)expected;
+	std::this_thread::yield();
+#endif
+}
+
+// Returns after the timeout at the latest.
+inline void futex_wait_for(std::atomic<int>& state, int expected, std::chrono::nanoseconds timeout)
+{
+#ifdef __linux__
+	struct timespec relative_timeout;
+	relative_timeout.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+	relative_timeout.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+	syscall(SYS_futex, reinterpret_cast<int*>(&state), FUTEX_WAIT_PRIVATE, expected, &relative_timeout, NULL, 0);
+#else
+	(void)state;
+	(void)expected;
+	(void)timeout;
+	std::this_thread::yield();
+#endif
+}
+
+inline void futex_wake_one(std::atomic<int>& state)
+{
+#ifdef __linux__
+	syscall(SYS_futex, reinterpret_cast<int*>(&state), FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#else
+	(void)state;
+#endif
+}
+
+} // namespace detail
+
+struct AdaptiveLockInitFunctor {
+	void operator()(std::atomic<int>& lock) {
+		lock.store(0, std::memory_order_relaxed);
+	}
+};
+
+struct AdaptiveLockDeinitFunctor {
+	void operator()(std::atomic<int>&) {
+	}
+};
+
+struct AdaptiveLockLockFunctor {
+	void operator()(std::atomic<int>& lock) {
+		for (unsigned int i = 0U; i < detail::adaptive_lock_spins; ++i) {
+			int state = 0;
+			if (lock.load(std::memory_order_relaxed) == 0 &&
+				lock.compare_exchange_weak(state, 1, std::memory_order_acquire, std::memory_order_relaxed))
+				return;
+			detail::cpu_relax();
+		}
+
+		// A thread that acquires the lock here sets the state to 2, since it cannot know whether other threads are sleeping.
+		while (lock.exchange(2, std::memory_order_acquire) != 0)
+			detail::futex_wait(lock, 2);
+	}
+
+	bool operator()(std::atomic<int>& lock, unsigned long timeout_ms) {
+		int state = 0;
+		if (lock.compare_exchange_strong(state, 1, std::memory_order_acquire, std::memory_order_relaxed))
+			return true;
+		if (timeout_ms == 0UL)
+			return false;
+
+		const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+		for (unsigned int i = 0U; i < detail::adaptive_lock_spins; ++i) {
+			state = 0;
+			if (lock.load(std::memory_order_relaxed) == 0 &&
+				lock.compare_exchange_weak(state, 1, std::memory_order_acquire, std::memory_order_relaxed))
+				return true;
+			detail::cpu_relax();
+		}
+
+		// Giving up leaves the state at 2, which costs the holder an unnecessary wake-up at most.
+		while (lock.exchange(2, std::memory_order_acquire) != 0) {
+			const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			if (now >= deadline)
+				return false;
+			detail::futex_wait_for(lock, 2, deadline - now);
+		}
+		return true;
+	}
+};
+
+struct AdaptiveLockUnlockFunctor {
+	void operator()(std::atomic<int>& lock) {
+		if (lock.exchange(0, std::memory_order_release) == 2)
+			detail::futex_wake_one(lock);
+	}
+};
+
+typedef ResourceLock<std::atomic<int>, AdaptiveLockInitFunctor, AdaptiveLockDeinitFunctor, AdaptiveLockLockFunctor, AdaptiveLockUnlockFunctor> AdaptiveLock;
+
+} // namespace
+
+#endif
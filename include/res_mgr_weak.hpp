@@ -0,0 +1,224 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2026 MH Lim
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef RESOURCE_MANAGER_WEAK_HPP
+#define RESOURCE_MANAGER_WEAK_HPP
+
+#include "res_mgr_atomic.hpp"
+#include "res_mgr_resource.hpp"
+#include "res_mgr_shared.hpp"
+#include <cstddef>
+
+namespace res_mgr {
+
+/*
+The control block of a shared resource that can be referred to by WeakResource.
+The strong count is the reference count of SharedResource and must be the first member.
+The weak count is the number of weak references, plus one as long as the strong count is not 0.
+*/
+template<typename RefCountAtomicType>
+struct WeakRefCountBlock
+{
+	RefCountAtomicType strong;
+	RefCountAtomicType weak;
+};
+
+/*
+A reference count allocator for SharedResource (see RefCountAllocator in res_mgr_shared.hpp), which allocates
+the strong and the weak reference count in the same block.
+A SharedResource must use it in order to be referred to by WeakResource.
+e.g. SharedResource<int, -1, SocketFunctor, long, std::atomic<long>, WeakRefCountAllocator<long, std::atomic<long> > >
+*/
+template<typename RefCountType, typename RefCountAtomicType>
+struct WeakRefCountAllocator
+{
+	typedef WeakRefCountBlock<RefCountAtomicType> block_type;
+
+	template<typename ResourceType>
+	static RefCountAtomicType* allocate(ResourceType)
+	{
+		block_type* p_block = new block_type;
+		atomic_store<RefCountType, RefCountAtomicType>(&(p_block->weak), 1, memory_order_relaxed);
+		return &(p_block->strong);
+	}
+
+	// Called when the strong count drops to 0.
+	static void deallocate(RefCountAtomicType* p_refcount)
+	{
+		release_weak(get_block(p_refcount));
+	}
+
+	static block_type* get_block(RefCountAtomicType* p_refcount)
+	{
+		return reinterpret_cast<block_type*>(p_refcount);
+	}
+
+	static void add_weak(block_type* p_block)
+	{
+		atomic_increment<RefCountType, RefCountAtomicType>(&(p_block->weak), memory_order_relaxed);
+	}
+
+	static void release_weak(block_type* p_block)
+	{
+		if (0 == atomic_decrement<RefCountType, RefCountAtomicType>(&(p_block->weak), memory_order_release))
+		{
+			atomic_fence<RefCountType, RefCountAtomicType>(memory_order_acquire);
+			delete p_block;
+		}
+	}
+
+	// Adds a strong reference unless the strong count has already dropped to 0, without taking any lock.
+	static bool try_add_strong(block_type* p_block)
+	{
+		RefCountType count = atomic_load<RefCountType, RefCountAtomicType>(&(p_block->strong), memory_order_relaxed);
+		while (count != 0)
+		{
+			if (atomic_compare_exchange_weak<RefCountType, RefCountAtomicType>(&(p_block->strong), count, count + 1,
+				memory_order_acq_rel, memory_order_relaxed))
+				return true;
+		}
+		return false;
+	}
+};
+
+/*
+A weak reference to a resource shared by SharedResource.
+A weak reference does not keep the resource from being released, it keeps only the control block alive.
+lock() returns a SharedResource holding the resource if it has not been released yet, or an invalid SharedResource otherwise.
+Template parameters:
+1) SharedResourceType: a SharedResource type whose RefCountAllocator is WeakRefCountAllocator
+
+e.g.
+typedef res_mgr::SharedResource<int, -1, SocketFunctor, long, std::atomic<long>, res_mgr::WeakRefCountAllocator<long, std::atomic<long> > > SharedSocket;
+typedef res_mgr::WeakResource<SharedSocket> WeakSocket;
+
+SharedSocket socket = ::socket(AF_INET, SOCK_STREAM, 0);
+WeakSocket cached = socket;
+...
+SharedSocket s = cached.lock();
+if (s.is_valid()) {
+	// the socket is still open
+}
+*/
+template<class SharedResourceType>
+class WeakResource
+{
+public:
+	typedef typename SharedResourceType::resource_type ResourceType;
+	typedef typename SharedResourceType::functor_type ResourceFunctor;
+	typedef typename SharedResourceType::refcount_type RefCountType;
+	typedef typename SharedResourceType::refcount_atomic_type RefCountAtomicType;
+	typedef typename SharedResourceType::refcount_allocator_type RefCountAllocator;
+	typedef typename RefCountAllocator::block_type BlockType;
+
+	WeakResource() : m_storage(SharedResourceType::invalid_resource(), ResourceFunctor()), m_pBlock(NULL)
+	{
+	}
+
+	WeakResource(const SharedResourceType& src) : m_storage(src.m_storage.m_resource, src.m_storage.functor()), m_pBlock(NULL)
+	{
+		if (src.m_pRefCount != NULL)
+		{
+			m_pBlock = RefCountAllocator::get_block(src.m_pRefCount);
+			RefCountAllocator::add_weak(m_pBlock);
+		}
+	}
+
+	WeakResource(const WeakResource& src) : m_storage(src.m_storage.m_resource, src.m_storage.functor()), m_pBlock(src.m_pBlock)
+	{
+		if (m_pBlock != NULL)
+			RefCountAllocator::add_weak(m_pBlock);
+	}
+
+	~WeakResource()
+	{
+		reset();
+	}
+
+	WeakResource& operator=(const WeakResource& src)
+	{
+		WeakResource temp(src);
+		swap(temp);
+		return *this;
+	}
+
+	WeakResource& operator=(const SharedResourceType& src)
+	{
+		WeakResource temp(src);
+		swap(temp);
+		return *this;
+	}
+
+	void reset()
+	{
+		if (m_pBlock != NULL)
+		{
+			RefCountAllocator::release_weak(m_pBlock);
+			m_pBlock = NULL;
+		}
+		m_storage.m_resource = SharedResourceType::invalid_resource();
+	}
+
+	SharedResourceType lock() const
+	{
+		if (m_pBlock != NULL && RefCountAllocator::try_add_strong(m_pBlock))
+			return SharedResourceType(m_storage.m_resource, &(m_pBlock->strong), m_storage.functor());
+		return SharedResourceType();
+	}
+
+	bool expired() const
+	{
+		return (get_refcount() == 0);
+	}
+
+	// Returns the number of SharedResource instances holding the resource.
+	RefCountType get_refcount() const
+	{
+		return (m_pBlock != NULL) ? atomic_load<RefCountType, RefCountAtomicType>(&(m_pBlock->strong), memory_order_relaxed) : 0;
+	}
+
+	void swap(WeakResource& src)
+	{
+		if (this != &src)
+		{
+			ResourceType temp = m_storage.m_resource;
+			BlockType* p = m_pBlock;
+			m_storage.m_resource = src.m_storage.m_resource;
+			m_pBlock = src.m_pBlock;
+			src.m_storage.m_resource = temp;
+			src.m_pBlock = p;
+			m_storage.swap_functor(src.m_storage);
+		}
+	}
+
+private:
+	detail::ResourceStorage<ResourceType, ResourceFunctor> m_storage;
+	BlockType* m_pBlock;
+};
+
+} // namespace
+
+#endif